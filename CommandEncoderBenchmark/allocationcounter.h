@@ -0,0 +1,12 @@
+#ifndef ALLOCATIONCOUNTER_H
+#define ALLOCATIONCOUNTER_H
+
+/** Returns the number of memory allocations of the program so far.
+ *
+ *  The allocations are counted by the replaced operator new in allocationcounter.cpp. The operators are
+ *  defined in their own translation unit, so the compiler does not inline free into the callers and
+ *  compare it with the allocation function.
+ */
+unsigned long getAllocationCount();
+
+#endif // ALLOCATIONCOUNTER_H
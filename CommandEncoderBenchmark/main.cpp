@@ -0,0 +1,180 @@
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "allocationcounter.h"
+#include "remotecommandencoder.h"
+#include "thalesremoteconnection.h"
+#include "thalesremotescriptwrapper.h"
+
+/*
+ * The command as it was built before, setValue -> to_string_with_precision -> executeRemoteCommand.
+ */
+std::string encodeWithStringstream(const std::string& name, double value) {
+    std::stringstream out;
+    out << std::scientific << std::setprecision(10) << value;
+    std::string command = name + "=" + out.str();
+    return "1:" + command + ":";
+}
+
+/*
+ * The command as it is built by the setters now.
+ */
+std::string_view encodeWithEncoder(RemoteCommandEncoder& command, std::string_view name, double value) {
+    command.clear();
+    command.append(name).append('=').appendScientific(value, 10).frame();
+    return command.view();
+}
+
+#ifndef _WIN32
+
+/*
+ * Connection to a simulated Term over a socket pair, so the setter can be measured without Term.
+ */
+class LoopbackConnection : public ZenniumConnection {
+   public:
+    void attach(int socket) {
+        this->socket_handle = socket;
+        this->startTelegramListener();
+    }
+
+    void detach() {
+        this->stopTelegramListener();
+        this->closeSocket();
+    }
+};
+
+/*
+ * Answers each telegram on the other end of the socket pair, Remote2 commands with "ok" and the
+ * version request of the wrapper with a version.
+ */
+static void answerCommands(int socket) {
+    std::vector<char> payload;
+    while (true) {
+        unsigned char header[3];
+        if (recv(socket, header, sizeof(header), MSG_WAITALL) != sizeof(header)) {
+            return;
+        }
+        payload.resize(header[0] | (header[1] << 8));
+        if (payload.empty() == false && recv(socket, payload.data(), payload.size(), MSG_WAITALL) != static_cast<long>(payload.size())) {
+            return;
+        }
+
+        const std::string_view reply = (header[2] == 128) ? "3,benchmark,6.1.0" : "ok";
+        const char replyHeader[3]    = {static_cast<char>(reply.size()), 0, static_cast<char>(header[2])};
+        send(socket, replyHeader, sizeof(replyHeader), MSG_NOSIGNAL);
+        send(socket, reply.data(), reply.size(), MSG_NOSIGNAL);
+    }
+}
+
+/*
+ * The complete setter, from encoding the command until the reply was received and checked.
+ */
+static void measureSetter(const std::vector<double>& values) {
+    int sockets[2];
+    socketpair(AF_UNIX, SOCK_STREAM, 0, sockets);
+    std::thread term(answerCommands, sockets[1]);
+
+    LoopbackConnection connection;
+    connection.attach(sockets[0]);
+    ThalesRemoteScriptWrapper wrapper(&connection);
+
+    // The first calls fill the buffer pool of the connection.
+    for (int i = 0; i < 100; i++) {
+        wrapper.setFrequency(values[i]);
+    }
+
+    auto allocationsBefore = getAllocationCount();
+    auto start             = std::chrono::steady_clock::now();
+    for (double value : values) {
+        wrapper.setFrequency(value);
+    }
+    auto time              = std::chrono::steady_clock::now() - start;
+    auto setterAllocations = getAllocationCount() - allocationsBefore;
+
+    connection.detach();
+    term.join();
+    close(sockets[1]);
+
+    std::cout << "setFrequency: " << std::chrono::duration<double, std::micro>(time).count() / values.size() << " us, "
+              << static_cast<double>(setterAllocations) / values.size() << " allocations per call including the round trip"
+              << std::endl;
+}
+
+#endif
+
+int main() {
+    const int numberOfCommands = 1000000;
+
+    std::mt19937_64 generator(42);
+    std::uniform_real_distribution<double> mantissa(-10.0, 10.0);
+    std::uniform_int_distribution<int> exponent(-12, 9);
+
+    std::vector<double> values;
+    values.reserve(numberOfCommands);
+    for (int i = 0; i < numberOfCommands; i++) {
+        values.push_back(mantissa(generator) * std::pow(10.0, exponent(generator)));
+    }
+
+    /*
+     * The encoder must produce exactly the same commands.
+     */
+    std::vector<double> specialValues = {0.0, -0.0, 1e300, -5e-324, 9.99999999995e-1, std::numeric_limits<double>::infinity()};
+    specialValues.insert(specialValues.end(), values.begin(), values.end());
+
+    RemoteCommandEncoder command;
+    for (double value : specialValues) {
+        if (encodeWithStringstream("Frq", value) != encodeWithEncoder(command, "Frq", value)) {
+            std::cout << "different command for " << value << std::endl;
+            return 1;
+        }
+    }
+
+    size_t totalLength = 0;
+
+    auto allocationsBefore = getAllocationCount();
+    auto start             = std::chrono::steady_clock::now();
+    for (double value : values) {
+        totalLength += encodeWithStringstream("Frq", value).size();
+    }
+    auto stringstreamTime        = std::chrono::steady_clock::now() - start;
+    auto stringstreamAllocations = getAllocationCount() - allocationsBefore;
+
+    allocationsBefore = getAllocationCount();
+    start             = std::chrono::steady_clock::now();
+    for (double value : values) {
+        totalLength += encodeWithEncoder(command, "Frq", value).size();
+    }
+    auto encoderTime        = std::chrono::steady_clock::now() - start;
+    auto encoderAllocations = getAllocationCount() - allocationsBefore;
+
+    auto nanosecondsPerCommand = [numberOfCommands](std::chrono::steady_clock::duration time) {
+        return std::chrono::duration<double, std::nano>(time).count() / numberOfCommands;
+    };
+
+    std::cout << "commands: " << numberOfCommands << " (" << totalLength << " bytes)" << std::endl;
+    std::cout << "stringstream: " << nanosecondsPerCommand(stringstreamTime) << " ns, "
+              << static_cast<double>(stringstreamAllocations) / numberOfCommands << " allocations per command" << std::endl;
+    std::cout << "encoder:      " << nanosecondsPerCommand(encoderTime) << " ns, "
+              << static_cast<double>(encoderAllocations) / numberOfCommands << " allocations per command" << std::endl;
+
+#ifndef _WIN32
+    // Values the frequency accepts, the complete setter is slower, so fewer calls are measured.
+    std::vector<double> frequencies;
+    for (int i = 0; i < 100000; i++) {
+        frequencies.push_back(std::abs(values[i]));
+    }
+    measureSetter(frequencies);
+#endif
+
+    // Only the encoding is free of allocations, the reply of the setter is received into a std::string.
+    return (encoderAllocations == 0) ? 0 : 1;
+}
@@ -0,0 +1,589 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "thalesremoteconnection.h"
+#include "threadsafequeue.h"
+
+#ifndef _WIN32
+
+#include <dlfcn.h>
+
+/*
+ * Counts the recv and send calls on the socket of the connection. The functions replace those of the
+ * C library for the whole program and forward to them, the simulated Term on the other socket is not counted.
+ */
+static std::atomic<int> countedSocket(-1);
+static std::atomic<unsigned long> recvCalls(0);
+static std::atomic<unsigned long> sendCalls(0);
+
+static void countSocketCalls(int socket) {
+    countedSocket = socket;
+    recvCalls     = 0;
+    sendCalls     = 0;
+}
+
+extern "C" ssize_t recv(int socket, void* buffer, size_t length, int flags) {
+    static auto next = reinterpret_cast<ssize_t (*)(int, void*, size_t, int)>(dlsym(RTLD_NEXT, "recv"));
+    recvCalls += (socket == countedSocket);
+    return next(socket, buffer, length, flags);
+}
+
+extern "C" ssize_t send(int socket, const void* buffer, size_t length, int flags) {
+    static auto next = reinterpret_cast<ssize_t (*)(int, const void*, size_t, int)>(dlsym(RTLD_NEXT, "send"));
+    sendCalls += (socket == countedSocket);
+    return next(socket, buffer, length, flags);
+}
+
+extern "C" ssize_t sendmsg(int socket, const struct msghdr* message, int flags) {
+    static auto next = reinterpret_cast<ssize_t (*)(int, const struct msghdr*, int)>(dlsym(RTLD_NEXT, "sendmsg"));
+    sendCalls += (socket == countedSocket);
+    return next(socket, message, flags);
+}
+
+/*
+ * Connection to a simulated Term over a socket pair, so the benchmark does not need Term.
+ */
+class LoopbackConnection : public ZenniumConnection {
+   public:
+    void attach(int socket) {
+        this->socket_handle = socket;
+        this->startTelegramListener();
+    }
+
+    void detach() {
+        this->stopTelegramListener();
+        this->closeSocket();
+    }
+};
+
+/*
+ * The other end of the socket pair. Reads the telegrams like Term, at most bytesPerMillisecond.
+ */
+class SimulatedTerm {
+   public:
+    using TelegramHandler = std::function<void(SimulatedTerm& term, int messageType, std::string_view payload)>;
+
+    SimulatedTerm(int socket, size_t bytesPerMillisecond, TelegramHandler handler) :
+        socket(socket), bytesPerMillisecond(bytesPerMillisecond), handler(std::move(handler)), thread(&SimulatedTerm::readTelegrams, this) {
+    }
+
+    ~SimulatedTerm() {
+        this->thread.join();
+        close(this->socket);
+    }
+
+    void send(int messageType, std::string_view payload) {
+        const char header[3] = {static_cast<char>(payload.size() & 0xFF), static_cast<char>(payload.size() >> 8), static_cast<char>(messageType)};
+        std::string telegram(header, sizeof(header));
+        telegram.append(payload);
+        ::send(this->socket, telegram.data(), telegram.size(), MSG_NOSIGNAL);
+    }
+
+   private:
+    int socket;
+    size_t bytesPerMillisecond;
+    TelegramHandler handler;
+    std::thread thread;
+
+    void readTelegrams() {
+        std::vector<char> buffer;
+        std::vector<char> block(std::min<size_t>(this->bytesPerMillisecond, 0x10000));
+
+        while (true) {
+            long received = recv(this->socket, block.data(), block.size(), 0);
+            if (received <= 0) {
+                return;
+            }
+            buffer.insert(buffer.end(), block.begin(), block.begin() + received);
+
+            size_t start = 0;
+            while (buffer.size() - start >= 3) {
+                const size_t length = static_cast<uint8_t>(buffer[start]) | (static_cast<uint8_t>(buffer[start + 1]) << 8);
+                if (buffer.size() - start < length + 3) {
+                    break;
+                }
+                this->handler(*this, static_cast<uint8_t>(buffer[start + 2]), std::string_view(buffer.data() + start + 3, length));
+                start += length + 3;
+            }
+            buffer.erase(buffer.begin(), buffer.begin() + start);
+
+            if (this->bytesPerMillisecond < 0x10000) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+    }
+};
+
+static void printLatencies(const std::string& name, std::vector<std::chrono::steady_clock::duration> latencies) {
+    std::sort(latencies.begin(), latencies.end());
+
+    auto microseconds = [&latencies](double fraction) {
+        auto index = std::min(latencies.size() - 1, static_cast<size_t>(fraction * latencies.size()));
+        return std::chrono::duration<double, std::micro>(latencies[index]).count();
+    };
+
+    std::cout << name << ": median " << microseconds(0.5) << " us, 99% " << microseconds(0.99) << " us, max " << microseconds(1.0) << " us"
+              << std::endl;
+}
+
+/*
+ * The reader before the receive buffer, for comparison: one recv for the header and at least one for
+ * the payload of each telegram. The telegrams are put into the queue until the socket is closed.
+ */
+static void readTelegramsOneByOne(int socket, ThreadsafeQueue& queue) {
+    auto receiveAll = [socket](uint8_t* data, size_t size) {
+        size_t received = 0;
+        while (received < size) {
+            long result = recv(socket, data + received, size - received, 0);
+            if (result <= 0) {
+                return false;
+            }
+            received += result;
+        }
+        return true;
+    };
+
+    while (true) {
+        uint8_t header[3];
+        if (receiveAll(header, sizeof(header)) == false) {
+            break;
+        }
+        std::vector<uint8_t> payload(header[0] | (header[1] << 8));
+        if (receiveAll(payload.data(), payload.size()) == false) {
+            break;
+        }
+        queue.put(Telegram(std::move(payload), header[2]));
+    }
+    queue.put(Telegram());
+}
+
+/*
+ * Writes the bursts to the socket and calls receive for each telegram. Returns the median time of a burst.
+ */
+template <typename Receive>
+static std::chrono::steady_clock::duration measureBursts(int socket, const std::string& burst, int numberOfTelegrams, int numberOfBursts, Receive receive) {
+    std::vector<std::chrono::steady_clock::duration> burstTimes;
+    for (int i = 0; i < numberOfBursts; i++) {
+        auto start = std::chrono::steady_clock::now();
+
+        std::thread sender([&]() {
+            size_t sent = 0;
+            while (sent < burst.size()) {
+                long result = ::send(socket, burst.data() + sent, burst.size() - sent, MSG_NOSIGNAL);
+                if (result <= 0) {
+                    return;
+                }
+                sent += result;
+            }
+        });
+
+        for (int j = 0; j < numberOfTelegrams; j++) {
+            receive();
+        }
+        burstTimes.push_back(std::chrono::steady_clock::now() - start);
+        sender.join();
+    }
+
+    std::sort(burstTimes.begin(), burstTimes.end());
+    return burstTimes[burstTimes.size() / 2];
+}
+
+/*
+ * Term sends bursts of small telegrams as fast as the socket allows, e.g. online data of a fast
+ * measurement. Measures the time until all telegrams of a burst were read with waitForTelegram and
+ * counts the recv calls, once with the receive buffer of the connection and once with the previous
+ * reader which reads one telegram per call.
+ */
+static void benchmarkReceiveBurst() {
+    const int numberOfTelegrams = 100000;
+    const int numberOfBursts    = 10;
+    const std::string payload   = "Pot=1.2345e-03";
+
+    std::string burst;
+    for (int i = 0; i < numberOfTelegrams; i++) {
+        const char header[3] = {static_cast<char>(payload.size()), 0, 2};
+        burst.append(header, sizeof(header));
+        burst.append(payload);
+    }
+
+    auto print = [&](const std::string& name, std::chrono::steady_clock::duration median) {
+        std::cout << "  " << name << ": median " << std::chrono::duration<double, std::milli>(median).count() << " ms, "
+                  << std::chrono::duration<double, std::nano>(median).count() / numberOfTelegrams << " ns per telegram, "
+                  << static_cast<double>(recvCalls) / (numberOfTelegrams * numberOfBursts) << " recv calls per telegram" << std::endl;
+    };
+
+    std::cout << "bursts of " << numberOfTelegrams << " telegrams with " << payload.size() << " bytes" << std::endl;
+
+    {
+        int sockets[2];
+        socketpair(AF_UNIX, SOCK_STREAM, 0, sockets);
+
+        LoopbackConnection connection;
+        connection.attach(sockets[0]);
+        countSocketCalls(sockets[0]);
+
+        auto median = measureBursts(sockets[1], burst, numberOfTelegrams, numberOfBursts, [&]() {
+            connection.releaseTelegram(connection.waitForTelegram(2));
+        });
+        print("receive buffer       ", median);
+
+        connection.detach();
+        close(sockets[1]);
+    }
+
+    {
+        int sockets[2];
+        socketpair(AF_UNIX, SOCK_STREAM, 0, sockets);
+
+        ThreadsafeQueue queue;
+        std::thread reader(readTelegramsOneByOne, sockets[0], std::ref(queue));
+        countSocketCalls(sockets[0]);
+
+        auto median = measureBursts(sockets[1], burst, numberOfTelegrams, numberOfBursts, [&]() {
+            queue.get();
+        });
+        print("one telegram per read", median);
+
+        close(sockets[1]);
+        reader.join();
+        close(sockets[0]);
+    }
+}
+
+/*
+ * The queue before the condition variable, for comparison: put unlocks a timed mutex on which get
+ * waits with try_lock_for, and get checks the timeout with the system clock.
+ */
+class TimedMutexQueue {
+   public:
+    TimedMutexQueue() {
+        dataAvailable.lock();
+    }
+
+    void put(std::vector<uint8_t> item) {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push_back(std::move(item));
+        dataAvailable.unlock();
+    }
+
+    std::vector<uint8_t> get(const std::chrono::duration<int, std::milli> timeout) {
+        auto startTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch());
+
+        while (this->empty() == true) {
+            auto elapsedTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()) - startTime;
+            if (elapsedTime > timeout) {
+                break;
+            }
+            dataAvailable.try_lock_for(timeout - elapsedTime);
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (queue.empty() == true) {
+            return {};
+        }
+        auto item = std::move(queue.front());
+        queue.pop_front();
+        return item;
+    }
+
+   private:
+    std::deque<std::vector<uint8_t>> queue;
+    mutable std::mutex mutex;
+    std::timed_mutex dataAvailable;
+
+    bool empty() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return queue.empty();
+    }
+};
+
+/*
+ * A thread waits in get while another thread calls put, like the receive thread does.
+ * Returns the times from put until the waiting thread has the telegram.
+ */
+template <typename Put, typename Get>
+static std::vector<std::chrono::steady_clock::duration> measureWakeups(int numberOfTelegrams, Put put, Get get) {
+    std::atomic<std::chrono::steady_clock::rep> putTime(0);
+    std::vector<std::chrono::steady_clock::duration> latencies;
+    latencies.reserve(numberOfTelegrams);
+
+    std::thread receiver([&]() {
+        for (int i = 0; i < numberOfTelegrams; i++) {
+            get();
+            latencies.push_back(std::chrono::steady_clock::now() - std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(putTime.load())));
+        }
+    });
+
+    for (int i = 0; i < numberOfTelegrams; i++) {
+        // The receiver is waiting again before the next telegram is put.
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+        putTime = std::chrono::steady_clock::now().time_since_epoch().count();
+        put();
+    }
+    receiver.join();
+
+    return latencies;
+}
+
+/*
+ * Measures the wakeup of a thread waiting in the queue of a channel, with the condition variable of
+ * ThreadsafeQueue and with the previous queue based on a timed mutex.
+ */
+static void benchmarkQueueWakeup() {
+    const int numberOfTelegrams = 5000;
+    const std::vector<uint8_t> payload = {'P', 'o', 't'};
+
+    std::cout << "wakeup of a thread waiting in the channel queue (" << numberOfTelegrams << " telegrams)" << std::endl;
+
+    ThreadsafeQueue queue;
+    printLatencies("  condition variable", measureWakeups(numberOfTelegrams, [&]() {
+        queue.put(Telegram(2, payload.data(), payload.size()));
+    }, [&]() {
+        queue.get();
+    }));
+
+    TimedMutexQueue timedMutexQueue;
+    printLatencies("  timed mutex       ", measureWakeups(numberOfTelegrams, [&]() {
+        timedMutexQueue.put(payload);
+    }, [&]() {
+        timedMutexQueue.get(std::chrono::milliseconds(2000));
+    }));
+}
+
+/*
+ * Four threads send small telegrams, e.g. setValue commands and heartbeats. Counts the send calls on
+ * the socket with and without the send queue, whose writer thread combines the queued telegrams into
+ * one write.
+ */
+static void benchmarkSendCoalescing(bool sendQueue) {
+    const int numberOfThreads   = 4;
+    const int telegramsPerThread = 10000;
+    const std::string payload   = "1:Frq=1.0000000000e+03:";
+
+    int sockets[2];
+    socketpair(AF_UNIX, SOCK_STREAM, 0, sockets);
+
+    std::atomic<int> received(0);
+    SimulatedTerm term(sockets[1], 0x10000, [&](SimulatedTerm&, int, std::string_view) {
+        received++;
+    });
+
+    LoopbackConnection connection;
+    connection.attach(sockets[0]);
+    if (sendQueue == true) {
+        connection.enableSendQueue();
+    }
+    countSocketCalls(sockets[0]);
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> senders;
+    for (int i = 0; i < numberOfThreads; i++) {
+        senders.emplace_back([&]() {
+            for (int j = 0; j < telegramsPerThread; j++) {
+                connection.sendTelegram(std::string_view(payload), 2);
+            }
+        });
+    }
+    for (auto& sender : senders) {
+        sender.join();
+    }
+    if (sendQueue == true) {
+        connection.disableSendQueue();
+    }
+    auto time = std::chrono::steady_clock::now() - start;
+
+    while (received < numberOfThreads * telegramsPerThread) {
+        std::this_thread::yield();
+    }
+    connection.detach();
+
+    std::cout << "  " << (sendQueue == true ? "send queue   " : "direct writes") << ": "
+              << std::chrono::duration<double, std::micro>(time).count() / (numberOfThreads * telegramsPerThread) << " us per telegram, "
+              << static_cast<double>(sendCalls) / (numberOfThreads * telegramsPerThread) << " send calls per telegram" << std::endl;
+}
+
+/*
+ * Two threads fill the send queue with large telegrams for a slow reader. A third thread sends an urgent
+ * telegram every 5 ms and measures how long the call takes and when the telegram arrives.
+ */
+static void benchmarkUrgentTelegrams() {
+    const int numberOfUrgentTelegrams = 200;
+    const std::string urgentPayload   = "1:Pot=0:";
+    const std::string bulkPayload(60000, 'x');
+
+    int sockets[2];
+    socketpair(AF_UNIX, SOCK_STREAM, 0, sockets);
+
+    // Small socket buffers, so the telegrams wait in the send queue and not in the kernel.
+    int bufferSize = 16384;
+    setsockopt(sockets[0], SOL_SOCKET, SO_SNDBUF, &bufferSize, sizeof(bufferSize));
+    setsockopt(sockets[1], SOL_SOCKET, SO_RCVBUF, &bufferSize, sizeof(bufferSize));
+
+    std::atomic<int> urgentArrived(0);
+    std::atomic<std::chrono::steady_clock::rep> urgentArrival(0);
+
+    SimulatedTerm term(sockets[1], 8192, [&](SimulatedTerm&, int, std::string_view payload) {
+        if (payload == urgentPayload) {
+            urgentArrival = std::chrono::steady_clock::now().time_since_epoch().count();
+            urgentArrived++;
+        }
+    });
+
+    LoopbackConnection connection;
+    connection.attach(sockets[0]);
+    connection.enableSendQueue();
+
+    std::atomic<bool> running(true);
+    std::vector<std::thread> bulkSenders;
+    for (int i = 0; i < 2; i++) {
+        bulkSenders.emplace_back([&]() {
+            while (running == true) {
+                connection.sendTelegram(std::string_view(bulkPayload), 2);
+            }
+        });
+    }
+
+    std::vector<std::chrono::steady_clock::duration> callLatencies;
+    std::vector<std::chrono::steady_clock::duration> arrivalLatencies;
+
+    for (int i = 0; i < numberOfUrgentTelegrams; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+        auto start = std::chrono::steady_clock::now();
+        connection.sendTelegram(std::as_bytes(std::span<const char>(urgentPayload.data(), urgentPayload.size())), 2, ZenniumConnection::SendPriority::URGENT);
+        callLatencies.push_back(std::chrono::steady_clock::now() - start);
+
+        while (urgentArrived <= i) {
+            std::this_thread::yield();
+        }
+        arrivalLatencies.push_back(std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(urgentArrival.load())) - start);
+    }
+
+    running = false;
+    for (auto& sender : bulkSenders) {
+        sender.join();
+    }
+    connection.disableSendQueue();
+    connection.detach();
+
+    std::cout << "urgent telegrams behind full send queue (" << numberOfUrgentTelegrams << " telegrams, reader 8 MB/s)" << std::endl;
+    printLatencies("  sendTelegram call", callLatencies);
+    printLatencies("  arrival at Term  ", arrivalLatencies);
+}
+
+/*
+ * Sends Remote2 commands to a simulated Term which answers each command after a network round trip
+ * of 1 ms. With pipeline depth 1 each command waits for the previous reply, with a larger depth the
+ * commands are sent before the previous replies have arrived.
+ */
+static void benchmarkPipelining(int pipelineDepth) {
+    const int numberOfCommands = 1000;
+    const auto roundTripTime   = std::chrono::milliseconds(1);
+
+    int sockets[2];
+    socketpair(AF_UNIX, SOCK_STREAM, 0, sockets);
+
+    // The replies are delayed by a separate thread, Term itself answers immediately.
+    std::mutex delayedRepliesMutex;
+    std::condition_variable delayedReplyAvailable;
+    std::deque<std::pair<std::chrono::steady_clock::time_point, std::string>> delayedReplies;
+    bool running = true;
+
+    SimulatedTerm term(sockets[1], 0x10000, [&](SimulatedTerm&, int messageType, std::string_view payload) {
+        if (messageType == 2) {
+            std::lock_guard<std::mutex> lock(delayedRepliesMutex);
+            delayedReplies.emplace_back(std::chrono::steady_clock::now() + roundTripTime, std::string(payload.substr(2, payload.size() - 3)));
+            delayedReplyAvailable.notify_one();
+        }
+    });
+
+    std::thread replySender([&]() {
+        std::unique_lock<std::mutex> lock(delayedRepliesMutex);
+        while (running == true || delayedReplies.empty() == false) {
+            if (delayedReplies.empty() == true) {
+                delayedReplyAvailable.wait(lock);
+                continue;
+            }
+            auto [due, reply] = delayedReplies.front();
+            if (delayedReplyAvailable.wait_until(lock, due, [&]() { return std::chrono::steady_clock::now() >= due; }) == true) {
+                delayedReplies.pop_front();
+                lock.unlock();
+                term.send(2, reply);
+                lock.lock();
+            }
+        }
+    });
+
+    LoopbackConnection connection;
+    connection.attach(sockets[0]);
+    connection.setPipelineDepth(pipelineDepth);
+
+    int wrongReplies = 0;
+    std::deque<std::pair<ZenniumConnection::ReplyToken, std::string>> requests;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < numberOfCommands; i++) {
+        std::string command = "Frq=" + std::to_string(i);
+
+        // Sending blocks while the pipeline is full, so the oldest reply is taken first.
+        if (static_cast<int>(requests.size()) == pipelineDepth) {
+            wrongReplies += (requests.front().first.getString() != requests.front().second);
+            requests.pop_front();
+        }
+        requests.emplace_back(connection.sendTelegramWithReplyToken("1:" + command + ":", 2, 2), command);
+    }
+    for (auto& request : requests) {
+        wrongReplies += (request.first.getString() != request.second);
+    }
+    auto time = std::chrono::steady_clock::now() - start;
+
+    {
+        std::lock_guard<std::mutex> lock(delayedRepliesMutex);
+        running = false;
+    }
+    delayedReplyAvailable.notify_one();
+    replySender.join();
+    connection.detach();
+
+    std::cout << "pipeline depth " << pipelineDepth << ": " << numberOfCommands << " commands in "
+              << std::chrono::duration<double, std::milli>(time).count() << " ms, "
+              << std::chrono::duration<double, std::micro>(time).count() / numberOfCommands << " us per command, "
+              << wrongReplies << " wrong replies" << std::endl;
+}
+
+int main() {
+    benchmarkReceiveBurst();
+    benchmarkQueueWakeup();
+
+    std::cout << "small telegrams from 4 threads" << std::endl;
+    benchmarkSendCoalescing(false);
+    benchmarkSendCoalescing(true);
+
+    benchmarkUrgentTelegrams();
+
+    std::cout << "pipelined Remote2 commands (round trip time 1 ms)" << std::endl;
+    for (int pipelineDepth : {1, 4, 16}) {
+        std::cout << "  ";
+        benchmarkPipelining(pipelineDepth);
+    }
+    return 0;
+}
+
+#else
+
+int main() {
+    std::cout << "The benchmark uses socket pairs and is only available on Linux." << std::endl;
+    return 0;
+}
+
+#endif
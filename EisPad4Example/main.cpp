@@ -15,7 +15,10 @@ int main(int argc, char *argv[]) {
     /*
      * Measure EIS spectra with a sequential number in the file name that has been specified.
      * Starting with number 1.
+     *
+     * The parameters are collected in a batch and sent in one telegram with commitParameterBatch.
      */
+    zahnerZennium.beginParameterBatch();
     zahnerZennium.setEISNaming(NamingRule::COUNTER);
     zahnerZennium.setEISCounter(1);
     zahnerZennium.setEISOutputPath("c:\\thales\\temp\\test1");
@@ -38,6 +41,12 @@ int main(int argc, char *argv[]) {
     zahnerZennium.setScanDirection(ScanDirection::START_TO_MAX);
     zahnerZennium.setScanStrategy(ScanStrategy::SINGLE_SINE);
 
+    for (const auto& result : zahnerZennium.commitParameterBatch()) {
+        if (result.success == false) {
+            std::cout << "parameter " << result.index << ", " << result.command << ": " << result.reply << std::endl;
+        }
+    }
+
     /*
      * Setup PAD4 Channels.
      * The PAD4 setup is encapsulated with try and catch to catch the exception if no PAD4 card is present.
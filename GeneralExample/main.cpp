@@ -16,6 +16,11 @@ int main(int argc, char *argv[]) {
 
     zahnerZennium.calibrateOffsets();
 
+    /*
+     * Parameters which already have the value, e.g. the amplitude in the spectrum, are not sent again.
+     */
+    zahnerZennium.enableParameterCache();
+
     zahnerZennium.setPotentiostatMode(PotentiostatMode::POTENTIOSTATIC);
     zahnerZennium.setPotential(1.0);
     zahnerZennium.enablePotentiostat();
@@ -52,6 +57,8 @@ int main(int argc, char *argv[]) {
     zahnerZennium.disablePotentiostat();
     zahnerZennium.setAmplitude(0);
 
+    std::cout << "parameter cache hits: " << zahnerZennium.getParameterCacheHits() << std::endl;
+
     ZenniumConnection.disconnectFromTerm();
 
     std::cout << "finish" << std::endl;
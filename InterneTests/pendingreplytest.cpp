@@ -0,0 +1,238 @@
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "telegramreactor.h"
+#include "termconnectionerror.h"
+#include "thalesremoteconnection.h"
+
+/*
+ * Tests the assignment of replies to requests with a socket pair instead of Term.
+ * The test plays Term itself: it reads the requests from the other end and writes the replies.
+ */
+
+class LoopbackConnection : public ZenniumConnection {
+   public:
+    using ZenniumConnection::ZenniumConnection;
+
+    void attach(int socket) {
+        this->socket_handle = socket;
+        this->startTelegramListener();
+    }
+
+    void detach() {
+        this->stopTelegramListener();
+        this->closeSocket();
+    }
+};
+
+static int failures = 0;
+
+#define CHECK(condition)                                                                      \
+    if ((condition) == false) {                                                               \
+        std::cout << __FILE__ << ":" << __LINE__ << ": check failed: " #condition << std::endl; \
+        failures++;                                                                           \
+    }
+
+static std::string readTelegram(int socket) {
+    unsigned char header[3];
+    recv(socket, header, sizeof(header), MSG_WAITALL);
+    std::string payload(header[0] | (header[1] << 8), '\0');
+    recv(socket, payload.data(), payload.size(), MSG_WAITALL);
+    return payload;
+}
+
+static void writeTelegram(int socket, std::string_view payload) {
+    const char header[3] = {static_cast<char>(payload.size() & 0xFF), static_cast<char>(payload.size() >> 8), 2};
+    send(socket, header, sizeof(header), MSG_NOSIGNAL);
+    send(socket, payload.data(), payload.size(), MSG_NOSIGNAL);
+}
+
+/*
+ * Returns the reply or "TIMEOUT".
+ */
+static std::string receiveReply(ZenniumConnection::ReplyToken& token, std::chrono::milliseconds timeout) {
+    try {
+        return token.getString(timeout);
+    } catch (const TermConnectionError&) {
+        return "TIMEOUT";
+    }
+}
+
+/*
+ * Term never answers the first command. After its timeout has passed once more, the next request
+ * must receive its own reply and not be shifted by the unanswered one.
+ */
+static void testUnansweredRequestExpires(LoopbackConnection& connection, int term) {
+    auto unanswered = connection.sendTelegramWithReplyToken("1:NOREPLY:", 2, 2);
+    CHECK(readTelegram(term) == "1:NOREPLY:");
+    CHECK(receiveReply(unanswered, std::chrono::milliseconds(100)) == "TIMEOUT");
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+
+    for (int i = 0; i < 3; i++) {
+        auto request = connection.sendTelegramWithReplyToken("1:Pot=" + std::to_string(i) + ":", 2, 2);
+        CHECK(readTelegram(term) == "1:Pot=" + std::to_string(i) + ":");
+        writeTelegram(term, "Pot=" + std::to_string(i));
+        CHECK(receiveReply(request, std::chrono::milliseconds(1000)) == "Pot=" + std::to_string(i));
+    }
+}
+
+/*
+ * Term answers the first command after its timeout. The late reply must be discarded and not be
+ * taken by the request sent in the meantime.
+ */
+static void testLateReplyIsDiscarded(LoopbackConnection& connection, int term) {
+    auto late = connection.sendTelegramWithReplyToken("1:SLOW:", 2, 2);
+    CHECK(readTelegram(term) == "1:SLOW:");
+    CHECK(receiveReply(late, std::chrono::milliseconds(100)) == "TIMEOUT");
+
+    auto request = connection.sendTelegramWithReplyToken("1:Pot=0:", 2, 2);
+    CHECK(readTelegram(term) == "1:Pot=0:");
+    writeTelegram(term, "SLOW");
+    writeTelegram(term, "Pot=0");
+    CHECK(receiveReply(request, std::chrono::milliseconds(1000)) == "Pot=0");
+}
+
+/*
+ * The reply does not start with the correlation key of the only waiting request.
+ * It must be assigned to that request instead of the queue of the channel.
+ */
+static void testUnmatchedKeyedReply(LoopbackConnection& connection, int term) {
+    auto request = connection.sendTelegramWithReplyToken("1,test", 2, 2, "1,test,");
+    CHECK(readTelegram(term) == "1,test");
+    writeTelegram(term, "3,test,6.1.0");
+    CHECK(receiveReply(request, std::chrono::milliseconds(1000)) == "3,test,6.1.0");
+}
+
+/*
+ * A token is destroyed without waiting for its reply, e.g. because the wait for an earlier reply
+ * threw. Its request must be cancelled, so it does not take the replies of the following requests.
+ */
+static void testDroppedTokenIsCancelled(LoopbackConnection& connection, int term) {
+    const auto timeout = connection.getTimeout();
+    connection.setTimeout(std::chrono::milliseconds(100));
+
+    {
+        auto dropped = connection.sendTelegramWithReplyToken("1:DROPPED:", 2, 2);
+        CHECK(readTelegram(term) == "1:DROPPED:");
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+
+    auto request = connection.sendTelegramWithReplyToken("1:Pot=0:", 2, 2);
+    CHECK(readTelegram(term) == "1:Pot=0:");
+    writeTelegram(term, "Pot=0");
+    CHECK(receiveReply(request, std::chrono::milliseconds(1000)) == "Pot=0");
+
+    connection.setTimeout(timeout);
+}
+
+/*
+ * A lock-free queue supports only one reader, so the methods which may read it from another thread
+ * must reject the channel. The queue is replaced only once, so the replaced queues do not accumulate.
+ */
+static void testLockFreeChannelRejectsSharedReading(LoopbackConnection& connection) {
+    connection.setChannelQueueLockFree(2, 16);
+
+    bool waitForAnyRejected = false;
+    try {
+        connection.waitForAny({2}, std::chrono::milliseconds(10));
+    } catch (const TermConnectionError&) {
+        waitForAnyRejected = true;
+    }
+    CHECK(waitForAnyRejected == true);
+
+    bool waitForTelegramAsyncRejected = false;
+    try {
+        connection.waitForTelegramAsync(2, [](const std::vector<uint8_t>&, std::exception_ptr) {});
+    } catch (const TermConnectionError&) {
+        waitForTelegramAsyncRejected = true;
+    }
+    CHECK(waitForTelegramAsyncRejected == true);
+
+    bool secondReplacementRejected = false;
+    try {
+        connection.setChannelQueueLockFree(2, 16);
+    } catch (const TermConnectionError&) {
+        secondReplacementRejected = true;
+    }
+    CHECK(secondReplacementRejected == true);
+}
+
+/*
+ * A reply callback of a reactor connection blocks until a second connection of the same reactor was
+ * removed. Removing needs the lock of the event loop, so the callback must be called without it.
+ */
+static void testReactorCallbackRunsWithoutLock() {
+    int sockets[2];
+    int otherSockets[2];
+    socketpair(AF_UNIX, SOCK_STREAM, 0, sockets);
+    socketpair(AF_UNIX, SOCK_STREAM, 0, otherSockets);
+
+    TelegramReactor reactor(1);
+    LoopbackConnection connection(&reactor);
+    LoopbackConnection otherConnection(&reactor);
+    connection.attach(sockets[0]);
+    otherConnection.attach(otherSockets[0]);
+
+    std::atomic<bool> callbackStarted(false);
+    std::atomic<bool> otherConnectionRemoved(false);
+    std::atomic<bool> removedDuringCallback(false);
+    std::atomic<bool> callbackFinished(false);
+
+    connection.sendStringAndWaitForReplyStringAsync("1:Pot=0:", 2, 2, [&](const std::string&, std::exception_ptr) {
+        callbackStarted = true;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(1000);
+        while (otherConnectionRemoved == false && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        removedDuringCallback = otherConnectionRemoved.load();
+        callbackFinished = true;
+    });
+    CHECK(readTelegram(sockets[1]) == "1:Pot=0:");
+    writeTelegram(sockets[1], "Pot=0");
+
+    while (callbackStarted == false) {
+        std::this_thread::yield();
+    }
+    otherConnection.detach();
+    otherConnectionRemoved = true;
+
+    while (callbackFinished == false) {
+        std::this_thread::yield();
+    }
+    connection.detach();
+    CHECK(removedDuringCallback == true);
+
+    close(sockets[1]);
+    close(otherSockets[1]);
+}
+
+int main() {
+    int sockets[2];
+    socketpair(AF_UNIX, SOCK_STREAM, 0, sockets);
+
+    LoopbackConnection connection;
+    connection.attach(sockets[0]);
+
+    testUnansweredRequestExpires(connection, sockets[1]);
+    testLateReplyIsDiscarded(connection, sockets[1]);
+    testDroppedTokenIsCancelled(connection, sockets[1]);
+    testUnmatchedKeyedReply(connection, sockets[1]);
+    testLockFreeChannelRejectsSharedReading(connection);
+
+    connection.detach();
+    close(sockets[1]);
+
+    testReactorCallbackRunsWithoutLock();
+
+    std::cout << (failures == 0 ? "all checks passed" : std::to_string(failures) + " checks failed") << std::endl;
+    return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,124 @@
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "allocationcounter.h"
+#include "replyparser.h"
+
+double stringToDouble(const std::string& string) {
+    std::stringstream stream(string);
+    double number;
+    stream >> number;
+    return number;
+}
+
+/*
+ * The replies as they were parsed before, getCurrent -> requestValueAndParseUsingRegexp -> parseValueUsingRegexp.
+ */
+double parseCurrentWithRegex(const std::string& reply, std::regex pattern) {
+    double result = std::nan("1");
+
+    std::regex replyStringPattern(pattern);
+    std::smatch match;
+    std::regex_search(reply, match, replyStringPattern);
+
+    if (match.size() > 1) {
+        result = stringToDouble(match.str(1));
+    }
+    return result;
+}
+
+std::complex<double> parseImpedanceWithRegex(const std::string& reply) {
+    std::complex<double> result(std::nan("1"), std::nan("1"));
+
+    std::regex replyStringPattern("impedance=\\s*(.*?),\\s*(.*?)\\\r");
+    std::smatch match;
+    std::regex_search(reply, match, replyStringPattern);
+
+    if (match.size() > 2) {
+        result = std::complex<double>(stringToDouble(match.str(1)), stringToDouble(match.str(2)));
+    }
+    return result;
+}
+
+/*
+ * Runs the parser for all replies and prints the time and the allocations per reply.
+ */
+template <typename Parser>
+bool measure(const std::string& name, const std::vector<std::string>& replies, Parser parser) {
+    double checksum = 0.0;
+
+    auto allocationsBefore = getAllocationCount();
+    auto start             = std::chrono::steady_clock::now();
+    for (const auto& reply : replies) {
+        checksum += std::abs(parser(reply));
+    }
+    auto time             = std::chrono::steady_clock::now() - start;
+    auto replyAllocations = getAllocationCount() - allocationsBefore;
+
+    std::cout << name << std::chrono::duration<double, std::nano>(time).count() / replies.size() << " ns, "
+              << static_cast<double>(replyAllocations) / replies.size() << " allocations per reply (checksum " << checksum << ")"
+              << std::endl;
+    return replyAllocations == 0;
+}
+
+int main() {
+    const int numberOfReplies = 10000;
+
+    std::mt19937_64 generator(42);
+    std::uniform_real_distribution<double> mantissa(-10.0, 10.0);
+    std::uniform_int_distribution<int> exponent(-12, 6);
+
+    auto randomValue = [&]() {
+        std::stringstream out;
+        out << std::scientific << std::setprecision(4) << mantissa(generator) * std::pow(10.0, exponent(generator));
+        return out.str();
+    };
+
+    std::vector<std::string> currentReplies;
+    std::vector<std::string> impedanceReplies;
+    for (int i = 0; i < numberOfReplies; i++) {
+        currentReplies.push_back("current= " + randomValue() + "A");
+        impedanceReplies.push_back("impedance=" + randomValue() + "," + randomValue() + "\r");
+    }
+
+    /*
+     * The parser must return exactly the same values.
+     */
+    for (int i = 0; i < numberOfReplies; i++) {
+        if (parseCurrentWithRegex(currentReplies[i], std::regex("current=\\s*(.*?)A")) != ReplyParser::parseValue(currentReplies[i], "current=", "A")) {
+            std::cout << "different value for " << currentReplies[i] << std::endl;
+            return 1;
+        }
+        if (parseImpedanceWithRegex(impedanceReplies[i]) != ReplyParser::parseImpedance(impedanceReplies[i])) {
+            std::cout << "different impedance for " << impedanceReplies[i] << std::endl;
+            return 1;
+        }
+    }
+
+    bool withoutAllocations = true;
+
+    std::cout << "replies: " << numberOfReplies << std::endl;
+    measure("current, regex:    ", currentReplies, [](const std::string& reply) {
+        return parseCurrentWithRegex(reply, std::regex("current=\\s*(.*?)A"));
+    });
+    withoutAllocations &= measure("current, parser:   ", currentReplies, [](const std::string& reply) {
+        return ReplyParser::parseValue(reply, "current=", "A");
+    });
+    measure("impedance, regex:  ", impedanceReplies, [](const std::string& reply) {
+        return parseImpedanceWithRegex(reply);
+    });
+    withoutAllocations &= measure("impedance, parser: ", impedanceReplies, [](const std::string& reply) {
+        return ReplyParser::parseImpedance(reply);
+    });
+
+    return withoutAllocations ? 0 : 1;
+}
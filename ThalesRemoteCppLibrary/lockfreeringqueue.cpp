@@ -0,0 +1,312 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "lockfreeringqueue.h"
+
+#include <stdexcept>
+#include <thread>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+#define CPU_RELAX() _mm_pause()
+#else
+#define CPU_RELAX()
+#endif
+
+namespace
+{
+    size_t roundUpToPowerOfTwo(size_t value)
+    {
+        size_t result = 1;
+        while (result < value)
+        {
+            result <<= 1;
+        }
+        return result;
+    }
+}
+
+LockFreeRingQueue::LockFreeRingQueue(size_t capacity, WaitStrategy waitStrategy, OverflowPolicy overflowPolicy) :
+    slots(roundUpToPowerOfTwo(capacity)),
+    capacity(capacity),
+    mask(roundUpToPowerOfTwo(capacity) - 1),
+    waitStrategy(waitStrategy),
+    overflowPolicy(overflowPolicy),
+    head(0),
+    tail(0),
+    releaseCount(0),
+    droppedCount(0),
+    interrupted(false),
+    waitingThreads(0)
+{
+    if (capacity == 0)
+    {
+        throw std::invalid_argument("The capacity of a LockFreeRingQueue must be at least 1.");
+    }
+    if (overflowPolicy != OverflowPolicy::BLOCK && overflowPolicy != OverflowPolicy::DROP_NEWEST)
+    {
+        throw std::invalid_argument("A LockFreeRingQueue only supports the overflow policies BLOCK and DROP_NEWEST.");
+    }
+}
+
+bool LockFreeRingQueue::empty() const
+{
+    return this->head.load(std::memory_order_acquire) == this->tail.load(std::memory_order_acquire)
+            && this->releaseCount.load(std::memory_order_acquire) == 0;
+}
+
+unsigned long LockFreeRingQueue::size() const
+{
+    const size_t tail = this->tail.load(std::memory_order_acquire);
+    const size_t head = this->head.load(std::memory_order_acquire);
+    return static_cast<unsigned long>(tail - head) + this->releaseCount.load(std::memory_order_acquire);
+}
+
+void LockFreeRingQueue::put(Telegram &&item)
+{
+    while (this->tryPut(std::move(item)) == false)
+    {
+        this->waitForSpace();
+    }
+}
+
+bool LockFreeRingQueue::tryPut(Telegram &&item)
+{
+    if (item.size() == 0)
+    {
+        this->releaseCount.fetch_add(1, std::memory_order_acq_rel);
+        this->wakeWaitingThreads();
+        return true;
+    }
+
+    const size_t tail = this->tail.load(std::memory_order_relaxed);
+
+    if (tail - this->head.load(std::memory_order_acquire) >= this->capacity)
+    {
+        if (this->overflowPolicy == OverflowPolicy::BLOCK && this->interrupted.load(std::memory_order_acquire) == false)
+        {
+            return false;
+        }
+        this->droppedCount.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    this->slots[tail & this->mask] = std::move(item);
+    this->tail.store(tail + 1, std::memory_order_release);
+    this->wakeWaitingThreads();
+    return true;
+}
+
+bool LockFreeRingQueue::waitForSpace()
+{
+    if (this->overflowPolicy == OverflowPolicy::BLOCK)
+    {
+        this->waitUntil([this]() {
+            return this->tail.load(std::memory_order_relaxed) - this->head.load(std::memory_order_acquire) < this->capacity
+                    || this->interrupted.load(std::memory_order_acquire) == true;
+        }, std::chrono::duration<int, std::milli>::max());
+    }
+    return this->interrupted.load(std::memory_order_acquire) == false;
+}
+
+void LockFreeRingQueue::setInterrupted(bool interrupted)
+{
+    this->interrupted.store(interrupted, std::memory_order_release);
+    this->wakeWaitingThreads();
+}
+
+void LockFreeRingQueue::setCapacity(size_t, OverflowPolicy)
+{
+    throw std::invalid_argument("The capacity of a LockFreeRingQueue cannot be changed.");
+}
+
+size_t LockFreeRingQueue::getCapacity() const
+{
+    return this->capacity;
+}
+
+TelegramQueue::OverflowPolicy LockFreeRingQueue::getOverflowPolicy() const
+{
+    return this->overflowPolicy;
+}
+
+unsigned long LockFreeRingQueue::getDroppedCount() const
+{
+    return this->droppedCount.load(std::memory_order_relaxed);
+}
+
+bool LockFreeRingQueue::isSingleReader() const
+{
+    return true;
+}
+
+Telegram LockFreeRingQueue::pop()
+{
+    const size_t head = this->head.load(std::memory_order_relaxed);
+
+    if (head == this->tail.load(std::memory_order_acquire))
+    {
+        // The empty elements are returned after the data.
+        auto releases = this->releaseCount.load(std::memory_order_acquire);
+        while (releases > 0 && this->releaseCount.compare_exchange_weak(releases, releases - 1, std::memory_order_acq_rel) == false)
+        {
+        }
+        return {};
+    }
+
+    Telegram item = std::move(this->slots[head & this->mask]);
+    this->head.store(head + 1, std::memory_order_release);
+
+    if (this->overflowPolicy == OverflowPolicy::BLOCK)
+    {
+        this->wakeWaitingThreads();
+    }
+    return item;
+}
+
+Telegram LockFreeRingQueue::get(const bool blocking, const std::chrono::duration<int, std::milli> timeout)
+{
+    if (blocking == true)
+    {
+        bool available = this->waitUntil([this]() {
+            return this->empty() == false;
+        }, timeout);
+
+        if (available == false)
+        {
+            return {};
+        }
+    }
+    return this->pop();
+}
+
+size_t LockFreeRingQueue::drain(std::vector<Telegram> &out, size_t maxCount, const std::chrono::duration<int, std::milli> timeout)
+{
+    bool available = this->waitUntil([this]() {
+        return this->empty() == false;
+    }, timeout);
+
+    if (available == false)
+    {
+        return 0;
+    }
+
+    const size_t head = this->head.load(std::memory_order_relaxed);
+    size_t count = this->tail.load(std::memory_order_acquire) - head;
+
+    if (count == 0)
+    {
+        // Only empty elements are left.
+        out.push_back(this->pop());
+        return 1;
+    }
+    if (maxCount != 0 && count > maxCount)
+    {
+        count = maxCount;
+    }
+
+    for (size_t index = head; index != head + count; index++)
+    {
+        out.push_back(std::move(this->slots[index & this->mask]));
+    }
+    this->head.store(head + count, std::memory_order_release);
+
+    if (this->overflowPolicy == OverflowPolicy::BLOCK)
+    {
+        this->wakeWaitingThreads();
+    }
+    return count;
+}
+
+template <typename Condition>
+bool LockFreeRingQueue::waitUntil(Condition condition, const std::chrono::duration<int, std::milli> timeout)
+{
+    const bool unlimited = (timeout == std::chrono::duration<int, std::milli>::max());
+    const auto deadline = std::chrono::steady_clock::now() + (unlimited ? std::chrono::milliseconds(0) : std::chrono::milliseconds(timeout));
+
+    if (this->waitStrategy == WaitStrategy::BLOCK)
+    {
+        if (condition() == true)
+        {
+            return true;
+        }
+
+        std::unique_lock<std::mutex> lock(this->waitMutex);
+
+        // Announce the waiting thread before checking the condition again, see wakeWaitingThreads.
+        this->waitingThreads.fetch_add(1, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        bool result = true;
+        if (unlimited == true)
+        {
+            this->waitCondition.wait(lock, condition);
+        }
+        else
+        {
+            result = this->waitCondition.wait_until(lock, deadline, condition);
+        }
+
+        this->waitingThreads.fetch_sub(1, std::memory_order_relaxed);
+        return result;
+    }
+
+    for (unsigned long iteration = 0; condition() == false; iteration++)
+    {
+        if (this->waitStrategy == WaitStrategy::SPIN_THEN_YIELD && iteration >= 1000)
+        {
+            std::this_thread::yield();
+        }
+        else
+        {
+            CPU_RELAX();
+        }
+
+        // Reading the clock is expensive compared to the condition.
+        if (unlimited == false && iteration % 256 == 0 && std::chrono::steady_clock::now() >= deadline)
+        {
+            return condition();
+        }
+    }
+    return true;
+}
+
+void LockFreeRingQueue::wakeWaitingThreads()
+{
+    if (this->waitStrategy != WaitStrategy::BLOCK)
+    {
+        return;
+    }
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (this->waitingThreads.load(std::memory_order_relaxed) > 0)
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->waitMutex);
+        }
+        this->waitCondition.notify_all();
+    }
+}
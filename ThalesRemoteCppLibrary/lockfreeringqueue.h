@@ -0,0 +1,123 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef LOCKFREERINGQUEUE_H
+#define LOCKFREERINGQUEUE_H
+
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include "telegramqueue.h"
+
+/** Queue for telegrams implemented as lock-free ring buffer.
+ *
+ *  The queue is meant for channels with a high telegram rate, e.g. online data or file chunks.
+ *  Writing and reading does not take a lock. Therefore only one thread may write, which is the receive
+ *  thread of the connection, and only one thread may read at the same time. Empty elements, which
+ *  release waiting threads, can be added by any thread.
+ *
+ *  The capacity is fixed. Because the writer must not remove elements, only the overflow policies
+ *  BLOCK and DROP_NEWEST are supported.
+ */
+class LockFreeRingQueue : public TelegramQueue
+{
+public:
+
+    /** How a thread waits for data or for space. */
+    enum class WaitStrategy
+    {
+        SPIN,               /**< Busy waiting, lowest latency but occupies a core. */
+        SPIN_THEN_YIELD,    /**< Busy waiting for a short time, then giving the core to other threads. */
+        BLOCK               /**< Sleeping on a condition variable, which is only notified if a thread waits. */
+    };
+
+    /** Constructor.
+     *
+     * @param capacity Maximum number of elements, must be at least 1.
+     * @param waitStrategy How a thread waits for data or for space.
+     * @param overflowPolicy BLOCK or DROP_NEWEST.
+     */
+    explicit LockFreeRingQueue(size_t capacity, WaitStrategy waitStrategy = WaitStrategy::BLOCK, OverflowPolicy overflowPolicy = OverflowPolicy::BLOCK);
+
+    using TelegramQueue::put;
+    using TelegramQueue::tryPut;
+
+    bool empty() const override;
+    unsigned long size() const override;
+    void put(Telegram &&item) override;
+    bool tryPut(Telegram &&item) override;
+    bool waitForSpace() override;
+    void setInterrupted(bool interrupted) override;
+
+    /** The capacity of the ring buffer cannot be changed, throws std::invalid_argument. */
+    void setCapacity(size_t capacity, OverflowPolicy overflowPolicy) override;
+
+    size_t getCapacity() const override;
+    OverflowPolicy getOverflowPolicy() const override;
+    unsigned long getDroppedCount() const override;
+
+    /** Only one thread may read the ring buffer, returns true. */
+    bool isSingleReader() const override;
+    Telegram pop() override;
+    Telegram get(const bool blocking = true, const std::chrono::duration<int, std::milli> timeout = std::chrono::duration<int, std::milli>::max()) override;
+    size_t drain(std::vector<Telegram> &out, size_t maxCount = 0, const std::chrono::duration<int, std::milli> timeout = std::chrono::duration<int, std::milli>::max()) override;
+
+protected:
+
+    std::vector<Telegram> slots;
+    const size_t capacity;
+    const size_t mask;
+    const WaitStrategy waitStrategy;
+    const OverflowPolicy overflowPolicy;
+
+    /** Index of the next element to read, only changed by the reader. */
+    alignas(64) std::atomic<size_t> head;
+
+    /** Index of the next element to write, only changed by the writer. */
+    alignas(64) std::atomic<size_t> tail;
+
+    /** Number of empty elements to return after the data. */
+    alignas(64) std::atomic<unsigned long> releaseCount;
+    std::atomic<unsigned long> droppedCount;
+    std::atomic<bool> interrupted;
+
+    std::mutex waitMutex;
+    std::condition_variable waitCondition;
+    std::atomic<int> waitingThreads;
+
+    /** Waits with the wait strategy until the condition is true.
+     *
+     * @param condition The condition to wait for.
+     * @param timeout The maximum time to wait, the maximum duration waits without limit.
+     * @return false if the timeout expired.
+     */
+    template <typename Condition>
+    bool waitUntil(Condition condition, const std::chrono::duration<int, std::milli> timeout);
+
+    /** Wakes up the threads which are blocked in waitUntil. */
+    void wakeWaitingThreads();
+};
+
+#endif // LOCKFREERINGQUEUE_H
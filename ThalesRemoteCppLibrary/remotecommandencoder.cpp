@@ -0,0 +1,103 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "remotecommandencoder.h"
+#include <charconv>
+#include <cstring>
+#include "thalesremoteerror.h"
+
+RemoteCommandEncoder::RemoteCommandEncoder() :
+    size(0)
+{
+
+}
+
+void RemoteCommandEncoder::clear()
+{
+    this->size = 0;
+}
+
+RemoteCommandEncoder& RemoteCommandEncoder::append(std::string_view text)
+{
+    if (text.size() > capacity - this->size)
+    {
+        throw ThalesRemoteError("The command is longer than " + std::to_string(capacity) + " characters.");
+    }
+
+    text.copy(this->buffer.data() + this->size, text.size());
+    this->size += text.size();
+    return *this;
+}
+
+RemoteCommandEncoder& RemoteCommandEncoder::append(char character)
+{
+    return this->append(std::string_view(&character, 1));
+}
+
+RemoteCommandEncoder& RemoteCommandEncoder::append(int value)
+{
+    auto result = std::to_chars(this->buffer.data() + this->size, this->buffer.data() + capacity, value);
+
+    if (result.ec != std::errc())
+    {
+        throw ThalesRemoteError("The command is longer than " + std::to_string(capacity) + " characters.");
+    }
+
+    this->size = result.ptr - this->buffer.data();
+    return *this;
+}
+
+RemoteCommandEncoder& RemoteCommandEncoder::appendScientific(double value, int precision)
+{
+    auto result = std::to_chars(this->buffer.data() + this->size, this->buffer.data() + capacity, value, std::chars_format::scientific, precision);
+
+    if (result.ec != std::errc())
+    {
+        throw ThalesRemoteError("The command is longer than " + std::to_string(capacity) + " characters.");
+    }
+
+    this->size = result.ptr - this->buffer.data();
+    return *this;
+}
+
+RemoteCommandEncoder& RemoteCommandEncoder::frame()
+{
+    constexpr std::string_view prefix = "1:";
+
+    if (prefix.size() + 1 > capacity - this->size)
+    {
+        throw ThalesRemoteError("The command is longer than " + std::to_string(capacity) + " characters.");
+    }
+
+    std::memmove(this->buffer.data() + prefix.size(), this->buffer.data(), this->size);
+    prefix.copy(this->buffer.data(), prefix.size());
+    this->size += prefix.size();
+    return this->append(':');
+}
+
+std::string_view RemoteCommandEncoder::view() const
+{
+    return std::string_view(this->buffer.data(), this->size);
+}
@@ -0,0 +1,96 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef REMOTECOMMANDENCODER_H
+#define REMOTECOMMANDENCODER_H
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+/** Builds Remote2 commands such as "1:Frq=1.0000000000e+03:" in a fixed buffer.
+ *
+ *  The numbers are formatted with std::to_chars, so encoding a command does not allocate memory.
+ *  The real numbers are formatted like std::scientific with std::setprecision, which was used before.
+ *  The content of the buffer can be passed to ZenniumConnection::sendTelegramWithReplyToken and is
+ *  written to the socket without being copied.
+ *
+ *  The encoder is intended to be placed on the stack for one command.
+ */
+class RemoteCommandEncoder
+{
+public:
+    /** Maximum length of an encoded command. Long text parameters, e.g. paths, are not encoded with this class. */
+    static constexpr std::size_t capacity = 256;
+
+    RemoteCommandEncoder();
+
+    /** Removes the encoded text. */
+    void clear();
+
+    /** Append text.
+     *
+     * \throws ThalesRemoteError if the command would exceed the capacity.
+     */
+    RemoteCommandEncoder& append(std::string_view text);
+
+    /** Append a single character.
+     *
+     * \throws ThalesRemoteError if the command would exceed the capacity.
+     */
+    RemoteCommandEncoder& append(char character);
+
+    /** Append an integer in decimal notation like std::to_string.
+     *
+     * \throws ThalesRemoteError if the command would exceed the capacity.
+     */
+    RemoteCommandEncoder& append(int value);
+
+    /** Append a real number in scientific notation, e.g. "1.0000000000e+03" for 1000 with 10 digits.
+     *
+     * \param  value The number.
+     * \param  precision The number of digits after the decimal point.
+     *
+     * \throws ThalesRemoteError if the command would exceed the capacity.
+     */
+    RemoteCommandEncoder& appendScientific(double value, int precision = 10);
+
+    /** Puts the appended commands into the Remote2 frame "1:<commands>:".
+     *
+     *  Called once after the commands were appended, e.g. "Frq=1.0000000000e+03" becomes "1:Frq=1.0000000000e+03:".
+     *
+     * \throws ThalesRemoteError if the command would exceed the capacity.
+     */
+    RemoteCommandEncoder& frame();
+
+    /** The encoded command, valid until the encoder is changed or destroyed. */
+    std::string_view view() const;
+
+protected:
+    std::array<char, capacity> buffer;
+    std::size_t size;
+};
+
+#endif  // REMOTECOMMANDENCODER_H
@@ -0,0 +1,311 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef REMOTEPARAMETERS_H
+#define REMOTEPARAMETERS_H
+
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <string_view>
+
+/** The Remote2 parameters which are set by the ThalesRemoteScriptWrapper.
+ *
+ *  The parameters are explained in https://doc.zahner.de/manuals/remote2.pdf .
+ */
+enum class RemoteParameter : std::size_t {
+    CURRENT,
+    POTENTIAL,
+    MAXIMUM_SHUNT_INDEX,
+    MINIMUM_SHUNT_INDEX,
+    VOLTAGE_RANGE_INDEX,
+    POTENTIOSTAT,
+    POTENTIOSTAT_WITHOUT_STATE_CHANGE,
+    RULE_FILE_USAGE,
+    PAD4_MODE,
+    PAD4_ENABLED,
+    FREQUENCY,
+    AMPLITUDE,
+    NUMBER_OF_PERIODS,
+    UPPER_FREQUENCY_LIMIT,
+    LOWER_FREQUENCY_LIMIT,
+    START_FREQUENCY,
+    UPPER_STEPS_PER_DECADE,
+    LOWER_STEPS_PER_DECADE,
+    UPPER_NUMBER_OF_PERIODS,
+    LOWER_NUMBER_OF_PERIODS,
+    SCAN_STRATEGY,
+    SCAN_DIRECTION,
+    EIS_NAMING,
+    EIS_COUNTER,
+    EIS_OUTPUT_PATH,
+    EIS_OUTPUT_FILE_NAME,
+    CV_START_POTENTIAL,
+    CV_UPPER_REVERSING_POTENTIAL,
+    CV_LOWER_REVERSING_POTENTIAL,
+    CV_END_POTENTIAL,
+    CV_START_HOLD_TIME,
+    CV_END_HOLD_TIME,
+    CV_SCAN_RATE,
+    CV_CYCLES,
+    CV_SAMPLES_PER_CYCLE,
+    CV_MAXIMUM_CURRENT,
+    CV_MINIMUM_CURRENT,
+    CV_OHMIC_DROP,
+    CV_AUTO_RESTART_AT_CURRENT_OVERFLOW,
+    CV_AUTO_RESTART_AT_CURRENT_UNDERFLOW,
+    CV_ANALOG_FUNCTION_GENERATOR,
+    CV_NAMING,
+    CV_COUNTER,
+    CV_OUTPUT_PATH,
+    CV_OUTPUT_FILE_NAME,
+    IE_FIRST_EDGE_POTENTIAL,
+    IE_SECOND_EDGE_POTENTIAL,
+    IE_THIRD_EDGE_POTENTIAL,
+    IE_FOURTH_EDGE_POTENTIAL,
+    IE_FIRST_EDGE_POTENTIAL_RELATION,
+    IE_SECOND_EDGE_POTENTIAL_RELATION,
+    IE_THIRD_EDGE_POTENTIAL_RELATION,
+    IE_FOURTH_EDGE_POTENTIAL_RELATION,
+    IE_POTENTIAL_RESOLUTION,
+    IE_MINIMUM_WAITING_TIME,
+    IE_MAXIMUM_WAITING_TIME,
+    IE_RELATIVE_TOLERANCE,
+    IE_ABSOLUTE_TOLERANCE,
+    IE_OHMIC_DROP,
+    IE_SWEEP_MODE,
+    IE_SCAN_RATE,
+    IE_MAXIMUM_CURRENT,
+    IE_MINIMUM_CURRENT,
+    IE_NAMING,
+    IE_COUNTER,
+    IE_OUTPUT_PATH,
+    IE_OUTPUT_FILE_NAME,
+    SEQUENCE_NAMING,
+    SEQUENCE_COUNTER,
+    SEQUENCE_OUTPUT_PATH,
+    SEQUENCE_OUTPUT_FILE_NAME,
+    SEQUENCE_ACQ_ENABLED,
+    SEQUENCE_OHMIC_DROP,
+    SEQUENCE_MAXIMUM_RUNTIME,
+    SEQUENCE_UPPER_POTENTIAL_LIMIT,
+    SEQUENCE_LOWER_POTENTIAL_LIMIT,
+    SEQUENCE_UPPER_CURRENT_LIMIT,
+    SEQUENCE_LOWER_CURRENT_LIMIT,
+    SEQUENCE_CURRENT_RANGE,
+    SEQUENCE_POTENTIAL_LATENCY_WINDOW,
+    SEQUENCE_CURRENT_LATENCY_WINDOW,
+    FRA_MODE,
+    FRA_VOLTAGE_INPUT_GAIN,
+    FRA_VOLTAGE_INPUT_OFFSET,
+    FRA_VOLTAGE_OUTPUT_GAIN,
+    FRA_VOLTAGE_OUTPUT_OFFSET,
+    FRA_VOLTAGE_MINIMUM,
+    FRA_VOLTAGE_MAXIMUM,
+    FRA_CURRENT_INPUT_GAIN,
+    FRA_CURRENT_INPUT_OFFSET,
+    FRA_CURRENT_OUTPUT_GAIN,
+    FRA_CURRENT_OUTPUT_OFFSET,
+    FRA_CURRENT_MINIMUM,
+    FRA_CURRENT_MAXIMUM,
+    ACQ_CHANNEL,
+    NUMBER_OF_PARAMETERS
+};
+
+/** The type of the value of a Remote2 parameter. */
+enum class RemoteParameterType {
+    INTEGER, /**< Integer number, sent with std::to_string. */
+    REAL,    /**< Real number, sent in scientific notation with 10 digits. */
+    BOOLEAN, /**< Sent as 1 or 0. */
+    TEXT     /**< Sent unchanged, e.g. paths. */
+};
+
+/** Description of a Remote2 parameter. */
+struct RemoteParameterDescription {
+    RemoteParameter parameter; /**< The parameter, equal to the index in the table. */
+    std::string_view name;     /**< The name in Remote2, e.g. "Frq". */
+    RemoteParameterType type;  /**< The type of the value. */
+    double scale   = 1;        /**< Factor from the unit of the setter to the unit of Remote2, e.g. 1e3 from V to mV. */
+    double minimum = -std::numeric_limits<double>::infinity(); /**< Smallest valid value in the unit of the setter. */
+    double maximum = std::numeric_limits<double>::infinity();  /**< Largest valid value in the unit of the setter. */
+};
+
+/** Limit of a parameter which is only limited in one direction. */
+inline constexpr double UNLIMITED_PARAMETER_VALUE = std::numeric_limits<double>::infinity();
+
+/** Table of the Remote2 parameters in the order of RemoteParameter.
+ *
+ *  The limits are checked before a value is sent, so invalid values are rejected without a round trip.
+ *  Parameters without a known limit are limited only by their type.
+ *  Each parameter needs a setter in ThalesRemoteScriptWrapper, the build checks this with ParameterSetters.
+ */
+inline constexpr std::array<RemoteParameterDescription, static_cast<std::size_t>(RemoteParameter::NUMBER_OF_PARAMETERS)>
+    remoteParameters = {{
+    {RemoteParameter::CURRENT,                              "Cset", RemoteParameterType::REAL},
+    {RemoteParameter::POTENTIAL,                            "Pset", RemoteParameterType::REAL},
+    {RemoteParameter::MAXIMUM_SHUNT_INDEX,                  "Rmax", RemoteParameterType::INTEGER, 1, 0, UNLIMITED_PARAMETER_VALUE},
+    {RemoteParameter::MINIMUM_SHUNT_INDEX,                  "Rmin", RemoteParameterType::INTEGER, 1, 0, UNLIMITED_PARAMETER_VALUE},
+    {RemoteParameter::VOLTAGE_RANGE_INDEX,                  "Potrange", RemoteParameterType::INTEGER, 1, 0, UNLIMITED_PARAMETER_VALUE},
+    {RemoteParameter::POTENTIOSTAT,                         "DEV%", RemoteParameterType::INTEGER, 1, 0, UNLIMITED_PARAMETER_VALUE},
+    {RemoteParameter::POTENTIOSTAT_WITHOUT_STATE_CHANGE,    "DEVHOT%", RemoteParameterType::INTEGER, 1, 0, UNLIMITED_PARAMETER_VALUE},
+    {RemoteParameter::RULE_FILE_USAGE,                      "UseRuleFile", RemoteParameterType::BOOLEAN},
+    {RemoteParameter::PAD4_MODE,                            "PAD4MOD", RemoteParameterType::INTEGER, 1, 0, 1},
+    {RemoteParameter::PAD4_ENABLED,                         "PAD4ENA", RemoteParameterType::BOOLEAN},
+    {RemoteParameter::FREQUENCY,                            "Frq", RemoteParameterType::REAL, 1, 0, UNLIMITED_PARAMETER_VALUE},
+    {RemoteParameter::AMPLITUDE,                            "Ampl", RemoteParameterType::REAL, 1e3, 0, UNLIMITED_PARAMETER_VALUE},  // Amplitude in V or A, Remote2 expects mV or mA.
+    {RemoteParameter::NUMBER_OF_PERIODS,                    "Nw", RemoteParameterType::INTEGER, 1, 1, 100},
+    {RemoteParameter::UPPER_FREQUENCY_LIMIT,                "Fmax", RemoteParameterType::REAL, 1, 0, UNLIMITED_PARAMETER_VALUE},
+    {RemoteParameter::LOWER_FREQUENCY_LIMIT,                "Fmin", RemoteParameterType::REAL, 1, 0, UNLIMITED_PARAMETER_VALUE},
+    {RemoteParameter::START_FREQUENCY,                      "Fstart", RemoteParameterType::REAL, 1, 0, UNLIMITED_PARAMETER_VALUE},
+    {RemoteParameter::UPPER_STEPS_PER_DECADE,               "dfm", RemoteParameterType::INTEGER, 1, 1, UNLIMITED_PARAMETER_VALUE},
+    {RemoteParameter::LOWER_STEPS_PER_DECADE,               "dfl", RemoteParameterType::INTEGER, 1, 1, UNLIMITED_PARAMETER_VALUE},
+    {RemoteParameter::UPPER_NUMBER_OF_PERIODS,              "Nws", RemoteParameterType::INTEGER, 1, 1, UNLIMITED_PARAMETER_VALUE},
+    {RemoteParameter::LOWER_NUMBER_OF_PERIODS,              "Nwl", RemoteParameterType::INTEGER, 1, 1, UNLIMITED_PARAMETER_VALUE},
+    {RemoteParameter::SCAN_STRATEGY,                        "ScanStrategy", RemoteParameterType::INTEGER, 1, 0, 2},
+    {RemoteParameter::SCAN_DIRECTION,                       "ScanDirection", RemoteParameterType::INTEGER, 1, 0, 1},
+    {RemoteParameter::EIS_NAMING,                           "EIS_MOD", RemoteParameterType::INTEGER, 1, 0, 2},
+    {RemoteParameter::EIS_COUNTER,                          "EIS_NUM", RemoteParameterType::INTEGER, 1, 0, UNLIMITED_PARAMETER_VALUE},
+    {RemoteParameter::EIS_OUTPUT_PATH,                      "EIS_PATH", RemoteParameterType::TEXT},
+    {RemoteParameter::EIS_OUTPUT_FILE_NAME,                 "EIS_ROOT", RemoteParameterType::TEXT},
+    {RemoteParameter::CV_START_POTENTIAL,                   "CV_Pstart", RemoteParameterType::REAL},
+    {RemoteParameter::CV_UPPER_REVERSING_POTENTIAL,         "CV_Pupper", RemoteParameterType::REAL},
+    {RemoteParameter::CV_LOWER_REVERSING_POTENTIAL,         "CV_Plower", RemoteParameterType::REAL},
+    {RemoteParameter::CV_END_POTENTIAL,                     "CV_Pend", RemoteParameterType::REAL},
+    {RemoteParameter::CV_START_HOLD_TIME,                   "CV_Tstart", RemoteParameterType::REAL, 1, 0, UNLIMITED_PARAMETER_VALUE},
+    {RemoteParameter::CV_END_HOLD_TIME,                     "CV_Tend", RemoteParameterType::REAL, 1, 0, UNLIMITED_PARAMETER_VALUE},
+    {RemoteParameter::CV_SCAN_RATE,                         "CV_Srate", RemoteParameterType::REAL, 1, 0, UNLIMITED_PARAMETER_VALUE},
+    {RemoteParameter::CV_CYCLES,                            "CV_Periods", RemoteParameterType::REAL, 1, 0, UNLIMITED_PARAMETER_VALUE},
+    {RemoteParameter::CV_SAMPLES_PER_CYCLE,                 "CV_PpPer", RemoteParameterType::REAL, 1, 0, UNLIMITED_PARAMETER_VALUE},
+    {RemoteParameter::CV_MAXIMUM_CURRENT,                   "CV_Ima", RemoteParameterType::REAL},
+    {RemoteParameter::CV_MINIMUM_CURRENT,                   "CV_Imi", RemoteParameterType::REAL},
+    {RemoteParameter::CV_OHMIC_DROP,                        "CV_Odrop", RemoteParameterType::REAL},
+    {RemoteParameter::CV_AUTO_RESTART_AT_CURRENT_OVERFLOW,  "CV_AutoReStart", RemoteParameterType::BOOLEAN},
+    {RemoteParameter::CV_AUTO_RESTART_AT_CURRENT_UNDERFLOW, "CV_AutoScale", RemoteParameterType::BOOLEAN},
+    {RemoteParameter::CV_ANALOG_FUNCTION_GENERATOR,         "CV_AFGena", RemoteParameterType::BOOLEAN},
+    {RemoteParameter::CV_NAMING,                            "CV_MOD", RemoteParameterType::INTEGER, 1, 0, 2},
+    {RemoteParameter::CV_COUNTER,                           "CV_NUM", RemoteParameterType::INTEGER, 1, 0, UNLIMITED_PARAMETER_VALUE},
+    {RemoteParameter::CV_OUTPUT_PATH,                       "CV_PATH", RemoteParameterType::TEXT},
+    {RemoteParameter::CV_OUTPUT_FILE_NAME,                  "CV_ROOT", RemoteParameterType::TEXT},
+    {RemoteParameter::IE_FIRST_EDGE_POTENTIAL,              "IE_EckPot1", RemoteParameterType::REAL},
+    {RemoteParameter::IE_SECOND_EDGE_POTENTIAL,             "IE_EckPot2", RemoteParameterType::REAL},
+    {RemoteParameter::IE_THIRD_EDGE_POTENTIAL,              "IE_EckPot3", RemoteParameterType::REAL},
+    {RemoteParameter::IE_FOURTH_EDGE_POTENTIAL,             "IE_EckPot4", RemoteParameterType::REAL},
+    {RemoteParameter::IE_FIRST_EDGE_POTENTIAL_RELATION,     "IE_EckPot1rel", RemoteParameterType::INTEGER, 1, -1, 0},
+    {RemoteParameter::IE_SECOND_EDGE_POTENTIAL_RELATION,    "IE_EckPot2rel", RemoteParameterType::INTEGER, 1, -1, 0},
+    {RemoteParameter::IE_THIRD_EDGE_POTENTIAL_RELATION,     "IE_EckPot3rel", RemoteParameterType::INTEGER, 1, -1, 0},
+    {RemoteParameter::IE_FOURTH_EDGE_POTENTIAL_RELATION,    "IE_EckPot4rel", RemoteParameterType::INTEGER, 1, -1, 0},
+    {RemoteParameter::IE_POTENTIAL_RESOLUTION,              "IE_Resolution", RemoteParameterType::REAL, 1, 0, UNLIMITED_PARAMETER_VALUE},
+    {RemoteParameter::IE_MINIMUM_WAITING_TIME,              "IE_WZmin", RemoteParameterType::REAL, 1, 0, UNLIMITED_PARAMETER_VALUE},
+    {RemoteParameter::IE_MAXIMUM_WAITING_TIME,              "IE_WZmax", RemoteParameterType::REAL, 1, 0, UNLIMITED_PARAMETER_VALUE},
+    {RemoteParameter::IE_RELATIVE_TOLERANCE,                "IE_Torel", RemoteParameterType::REAL, 1, 0, UNLIMITED_PARAMETER_VALUE},
+    {RemoteParameter::IE_ABSOLUTE_TOLERANCE,                "IE_Toabs", RemoteParameterType::REAL, 1, 0, UNLIMITED_PARAMETER_VALUE},
+    {RemoteParameter::IE_OHMIC_DROP,                        "IE_Odrop", RemoteParameterType::REAL},
+    {RemoteParameter::IE_SWEEP_MODE,                        "IE_SweepMode", RemoteParameterType::INTEGER, 1, 0, 2},
+    {RemoteParameter::IE_SCAN_RATE,                         "IE_Srate", RemoteParameterType::REAL, 1, 0, UNLIMITED_PARAMETER_VALUE},
+    {RemoteParameter::IE_MAXIMUM_CURRENT,                   "IE_Ima", RemoteParameterType::REAL},
+    {RemoteParameter::IE_MINIMUM_CURRENT,                   "IE_Imi", RemoteParameterType::REAL},
+    {RemoteParameter::IE_NAMING,                            "IE_MOD", RemoteParameterType::INTEGER, 1, 0, 2},
+    {RemoteParameter::IE_COUNTER,                           "IE_NUM", RemoteParameterType::INTEGER, 1, 0, UNLIMITED_PARAMETER_VALUE},
+    {RemoteParameter::IE_OUTPUT_PATH,                       "IE_PATH", RemoteParameterType::TEXT},
+    {RemoteParameter::IE_OUTPUT_FILE_NAME,                  "IE_ROOT", RemoteParameterType::TEXT},
+    {RemoteParameter::SEQUENCE_NAMING,                      "SEQ_MOD", RemoteParameterType::INTEGER, 1, 0, 2},
+    {RemoteParameter::SEQUENCE_COUNTER,                     "SEQ_NUM", RemoteParameterType::INTEGER, 1, 0, UNLIMITED_PARAMETER_VALUE},
+    {RemoteParameter::SEQUENCE_OUTPUT_PATH,                 "SEQ_PATH", RemoteParameterType::TEXT},
+    {RemoteParameter::SEQUENCE_OUTPUT_FILE_NAME,            "SEQ_ROOT", RemoteParameterType::TEXT},
+    {RemoteParameter::SEQUENCE_ACQ_ENABLED,                 "SEQ_ACQENA", RemoteParameterType::INTEGER, 1, -1, 0},  // -1 enables, 0 disables.
+    {RemoteParameter::SEQUENCE_OHMIC_DROP,                  "SEQ_RODROP", RemoteParameterType::REAL},
+    {RemoteParameter::SEQUENCE_MAXIMUM_RUNTIME,             "SEQ_MAXTIME", RemoteParameterType::REAL, 1, 0.1, 1000},  // Runtime in hours.
+    {RemoteParameter::SEQUENCE_UPPER_POTENTIAL_LIMIT,       "SEQ_EUPPER", RemoteParameterType::REAL},
+    {RemoteParameter::SEQUENCE_LOWER_POTENTIAL_LIMIT,       "SEQ_ELOWER", RemoteParameterType::REAL},
+    {RemoteParameter::SEQUENCE_UPPER_CURRENT_LIMIT,         "SEQ_IUPPER", RemoteParameterType::REAL},
+    {RemoteParameter::SEQUENCE_LOWER_CURRENT_LIMIT,         "SEQ_ILOWER", RemoteParameterType::REAL},
+    {RemoteParameter::SEQUENCE_CURRENT_RANGE,               "SEQ_IRANGE", RemoteParameterType::REAL, 1, 0, UNLIMITED_PARAMETER_VALUE},
+    {RemoteParameter::SEQUENCE_POTENTIAL_LATENCY_WINDOW,    "SEQ_POTOFLO", RemoteParameterType::REAL, 1, 0, 30},  // Seconds, 0, 1 and 2 have special meanings.
+    {RemoteParameter::SEQUENCE_CURRENT_LATENCY_WINDOW,      "SEQ_CUROFLO", RemoteParameterType::REAL, 1, 0, 30},  // Seconds, 0, 1 and 2 have special meanings.
+    {RemoteParameter::FRA_MODE,                             "FRA", RemoteParameterType::BOOLEAN},
+    {RemoteParameter::FRA_VOLTAGE_INPUT_GAIN,               "FRA_POT_IN", RemoteParameterType::REAL},
+    {RemoteParameter::FRA_VOLTAGE_INPUT_OFFSET,             "FRA_POT_IN_OFF", RemoteParameterType::REAL},
+    {RemoteParameter::FRA_VOLTAGE_OUTPUT_GAIN,              "FRA_POT_OUT", RemoteParameterType::REAL},
+    {RemoteParameter::FRA_VOLTAGE_OUTPUT_OFFSET,            "FRA_POT_OUT_OFF", RemoteParameterType::REAL},
+    {RemoteParameter::FRA_VOLTAGE_MINIMUM,                  "FRA_POT_MIN", RemoteParameterType::REAL},
+    {RemoteParameter::FRA_VOLTAGE_MAXIMUM,                  "FRA_POT_MAX", RemoteParameterType::REAL},
+    {RemoteParameter::FRA_CURRENT_INPUT_GAIN,               "FRA_CUR_IN", RemoteParameterType::REAL},
+    {RemoteParameter::FRA_CURRENT_INPUT_OFFSET,             "FRA_CUR_IN_OFF", RemoteParameterType::REAL},
+    {RemoteParameter::FRA_CURRENT_OUTPUT_GAIN,              "FRA_CUR_OUT", RemoteParameterType::REAL},
+    {RemoteParameter::FRA_CURRENT_OUTPUT_OFFSET,            "FRA_CUR_OUT_OFF", RemoteParameterType::REAL},
+    {RemoteParameter::FRA_CURRENT_MINIMUM,                  "FRA_CUR_MIN", RemoteParameterType::REAL},
+    {RemoteParameter::FRA_CURRENT_MAXIMUM,                  "FRA_CUR_MAX", RemoteParameterType::REAL},
+    {RemoteParameter::ACQ_CHANNEL,                          "CHANNEL", RemoteParameterType::INTEGER, 1, 0, UNLIMITED_PARAMETER_VALUE},
+}};
+
+/** Returns true if each entry of remoteParameters is at the index of its parameter. */
+constexpr bool remoteParameterTableIsOrdered() {
+    for (std::size_t index = 0; index < remoteParameters.size(); index++) {
+        if (static_cast<std::size_t>(remoteParameters[index].parameter) != index) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(remoteParameterTableIsOrdered(), "remoteParameters must be in the order of RemoteParameter.");
+
+/** Get the description of a parameter at compile time. */
+template <RemoteParameter parameter>
+constexpr const RemoteParameterDescription& remoteParameterDescription() {
+    return remoteParameters[static_cast<std::size_t>(parameter)];
+}
+
+/** The C++ type of the value of a parameter type. */
+template <RemoteParameterType type>
+struct RemoteParameterValueType;
+
+template <>
+struct RemoteParameterValueType<RemoteParameterType::INTEGER> {
+    using type = int;
+};
+
+template <>
+struct RemoteParameterValueType<RemoteParameterType::REAL> {
+    using type = double;
+};
+
+template <>
+struct RemoteParameterValueType<RemoteParameterType::BOOLEAN> {
+    using type = bool;
+};
+
+template <>
+struct RemoteParameterValueType<RemoteParameterType::TEXT> {
+    using type = std::string;
+};
+
+/** The C++ type of the value of a parameter, e.g. double for RemoteParameter::FREQUENCY. */
+template <RemoteParameter parameter>
+using RemoteParameterValue = typename RemoteParameterValueType<remoteParameterDescription<parameter>().type>::type;
+
+#endif  // REMOTEPARAMETERS_H
@@ -0,0 +1,210 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "replyparser.h"
+
+#include <charconv>
+#include <cmath>
+
+namespace {
+
+void skipWhitespace(std::string_view& text) {
+    while (text.empty() == false && (text.front() == ' ' || text.front() == '\t')) {
+        text.remove_prefix(1);
+    }
+}
+
+bool isDigit(char character) {
+    return character >= '0' && character <= '9';
+}
+
+}  // namespace
+
+bool ReplyParser::parseDouble(std::string_view& text, double& value) {
+    skipWhitespace(text);
+    if (text.empty() == false && text.front() == '+') {
+        text.remove_prefix(1);
+    }
+
+    auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (result.ec != std::errc()) {
+        return false;
+    }
+    text.remove_prefix(static_cast<size_t>(result.ptr - text.data()));
+    return true;
+}
+
+bool ReplyParser::parseInt(std::string_view& text, int& value) {
+    skipWhitespace(text);
+    if (text.empty() == false && text.front() == '+') {
+        text.remove_prefix(1);
+    }
+
+    auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (result.ec != std::errc()) {
+        return false;
+    }
+    text.remove_prefix(static_cast<size_t>(result.ptr - text.data()));
+    return true;
+}
+
+double ReplyParser::parseValue(std::string_view reply, std::string_view prefix, std::string_view unit) {
+    const auto start = reply.find(prefix);
+    if (start == std::string_view::npos) {
+        return std::nan("1");
+    }
+
+    auto text = reply.substr(start + prefix.size());
+    double value;
+    if (parseDouble(text, value) == false) {
+        return std::nan("1");
+    }
+
+    skipWhitespace(text);
+    if (unit.empty() == false && text.starts_with(unit) == false) {
+        return std::nan("1");
+    }
+    return value;
+}
+
+std::complex<double> ReplyParser::parseImpedance(std::string_view reply) {
+    const std::complex<double> invalid(std::nan("1"), std::nan("1"));
+    constexpr std::string_view prefix = "impedance=";
+
+    const auto start = reply.find(prefix);
+    if (start == std::string_view::npos) {
+        return invalid;
+    }
+
+    auto text = reply.substr(start + prefix.size());
+    double real;
+    double imaginary;
+    if (parseDouble(text, real) == false) {
+        return invalid;
+    }
+
+    skipWhitespace(text);
+    if (text.starts_with(',') == false) {
+        return invalid;
+    }
+    text.remove_prefix(1);
+
+    if (parseDouble(text, imaginary) == false) {
+        return invalid;
+    }
+
+    skipWhitespace(text);
+    if (text.starts_with('\r') == false) {
+        return invalid;
+    }
+    return std::complex<double>(real, imaginary);
+}
+
+bool ReplyParser::getControlReplyValue(std::string_view reply, std::string_view& value) {
+    const auto first = reply.find(',');
+    if (first == std::string_view::npos) {
+        return false;
+    }
+
+    const auto second = reply.find(',', first + 1);
+    if (second == std::string_view::npos) {
+        return false;
+    }
+    value = reply.substr(second + 1);
+    return true;
+}
+
+int ReplyParser::parseHeartBeat(std::string_view reply) {
+    // Only the last field is evaluated, the connection name may contain commas.
+    const auto separator = reply.rfind(',');
+    if (separator == std::string_view::npos || reply.find(',') == separator) {
+        return -1;
+    }
+
+    auto text = reply.substr(separator + 1);
+    if (text.empty() == true || isDigit(text.front()) == false) {
+        return -1;
+    }
+
+    int value;
+    if (parseInt(text, value) == false || text.empty() == false) {
+        return -1;
+    }
+    return value;
+}
+
+std::string_view ReplyParser::getDeviceField(std::string_view reply, size_t index) {
+    const auto last = reply.rfind(';');
+    if (last == std::string_view::npos || last == 0) {
+        return {};
+    }
+
+    const auto secondLast = reply.rfind(';', last - 1);
+    if (secondLast == std::string_view::npos) {
+        return {};
+    }
+
+    if (index == 0) {
+        return reply.substr(secondLast + 1, last - secondLast - 1);
+    }
+
+    // The device name consists of letters only.
+    auto name = reply.substr(last + 1);
+    size_t length = 0;
+    while (length < name.size() && ((name[length] >= 'a' && name[length] <= 'z') || (name[length] >= 'A' && name[length] <= 'Z'))) {
+        length++;
+    }
+    return name.substr(0, length);
+}
+
+bool ReplyParser::parseVersion(std::string_view text, std::array<int, 3>& version) {
+    for (size_t start = 0; start < text.size(); start++) {
+        if (isDigit(text[start]) == false || (start > 0 && isDigit(text[start - 1]) == true)) {
+            continue;
+        }
+
+        // The parts are separated by any single character, e.g. "6.1.0" or "6-1-0".
+        auto candidate = text.substr(start);
+        bool valid     = true;
+        for (size_t part = 0; part < version.size() && valid == true; part++) {
+            if (part > 0) {
+                valid = candidate.size() >= 2 && isDigit(candidate[1]) == true;
+                if (valid == true) {
+                    candidate.remove_prefix(1);
+                }
+            }
+            if (valid == true) {
+                auto result = std::from_chars(candidate.data(), candidate.data() + candidate.size(), version[part]);
+                valid       = result.ec == std::errc();
+                candidate.remove_prefix(static_cast<size_t>(result.ptr - candidate.data()));
+            }
+        }
+
+        if (valid == true) {
+            return true;
+        }
+    }
+    return false;
+}
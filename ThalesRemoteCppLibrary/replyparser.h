@@ -0,0 +1,115 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef REPLYPARSER_H
+#define REPLYPARSER_H
+
+#include <array>
+#include <complex>
+#include <cstddef>
+#include <string_view>
+
+/** Scanners for the fixed reply formats of Term and the Remote2 commands.
+ *
+ *  The replies are parsed in place with std::from_chars, without building regular expressions or
+ *  copying substrings, so the frequently polled getters like getCurrent do not allocate memory.
+ */
+class ReplyParser {
+public:
+    /** Parses a floating point number at the beginning of the text.
+     *
+     *  Leading whitespace and a plus sign are skipped like by the stream operators.
+     *
+     * \param  text The text, which is advanced behind the number.
+     * \param  value The parsed value.
+     *
+     * \return false if the text does not start with a number.
+     */
+    static bool parseDouble(std::string_view& text, double& value);
+
+    /** Parses an integer at the beginning of the text.
+     *
+     * \param  text The text, which is advanced behind the number.
+     * \param  value The parsed value.
+     *
+     * \return false if the text does not start with a number.
+     */
+    static bool parseInt(std::string_view& text, int& value);
+
+    /** Parses the value of replies like "current= 1.2345e-03A".
+     *
+     * \param  reply The response string from the device.
+     * \param  prefix The text in front of the value, e.g. "current=".
+     * \param  unit The text which must follow the value, e.g. "A", or empty if the value ends the reply.
+     *
+     * \return The value or NaN if the reply has a different format.
+     */
+    static double parseValue(std::string_view reply, std::string_view prefix, std::string_view unit = {});
+
+    /** Parses the reply of the IMPEDANCE command, "impedance=<real>,<imaginary>\r".
+     *
+     * \param  reply The response string from the device.
+     *
+     * \return The complex impedance or NaN if the reply has a different format.
+     */
+    static std::complex<double> parseImpedance(std::string_view reply);
+
+    /** Returns the text behind the second comma of control replies like "3,<name>,6.1.0".
+     *
+     * \param  reply The response string from Term.
+     * \param  value The text behind the second comma.
+     *
+     * \return false if the reply has less than three fields.
+     */
+    static bool getControlReplyValue(std::string_view reply, std::string_view& value);
+
+    /** Parses the heartbeat from the reply "1,<name>,<milliseconds>".
+     *
+     * \param  reply The response string from Term.
+     *
+     * \return The heartbeat or -1 if the reply has a different format.
+     */
+    static int parseHeartBeat(std::string_view reply);
+
+    /** Returns a field of the reply of the ALLNUM command, "<...>;<serial number>;<device name>".
+     *
+     * \param  reply The response string from the device.
+     * \param  index 0 for the serial number, 1 for the device name.
+     *
+     * \return The field or an empty view if the reply has a different format.
+     */
+    static std::string_view getDeviceField(std::string_view reply, size_t index);
+
+    /** Searches for the first version number "<major>.<minor>.<patch>" in the text.
+     *
+     * \param  text The text, e.g. the reply to getThalesVersion.
+     * \param  version The parsed version.
+     *
+     * \return false if the text contains no version number.
+     */
+    static bool parseVersion(std::string_view text, std::array<int, 3>& version);
+};
+
+#endif  // REPLYPARSER_H
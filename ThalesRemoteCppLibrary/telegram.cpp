@@ -0,0 +1,97 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "telegram.h"
+
+#include <cstring>
+#include "telegrambufferpool.h"
+
+Telegram::Telegram() :
+    inlineSize(0),
+    onHeap(false),
+    messageType(-1)
+{
+
+}
+
+Telegram::Telegram(int messageType, const uint8_t *payload, size_t size, TelegramBufferPool *pool, std::chrono::steady_clock::time_point receiveTime) :
+    inlineSize(0),
+    onHeap(size > inlineCapacity),
+    messageType(messageType),
+    receiveTime(receiveTime)
+{
+    if (this->onHeap == true)
+    {
+        if (pool != nullptr)
+        {
+            this->heapPayload = pool->acquire(size);
+        }
+        this->heapPayload.assign(payload, payload + size);
+    }
+    else
+    {
+        std::memcpy(this->inlinePayload.data(), payload, size);
+        this->inlineSize = size;
+    }
+}
+
+Telegram::Telegram(std::vector<uint8_t> &&payload, int messageType) :
+    heapPayload(std::move(payload)),
+    inlineSize(0),
+    onHeap(true),
+    messageType(messageType)
+{
+
+}
+
+std::vector<uint8_t> Telegram::toVector(TelegramBufferPool *pool)
+{
+    if (this->onHeap == true)
+    {
+        return this->releaseBuffer();
+    }
+
+    std::vector<uint8_t> payload;
+    if (pool != nullptr)
+    {
+        payload = pool->acquire(this->inlineSize);
+    }
+    payload.assign(this->inlinePayload.data(), this->inlinePayload.data() + this->inlineSize);
+    this->inlineSize = 0;
+    return payload;
+}
+
+std::vector<uint8_t> Telegram::releaseBuffer()
+{
+    std::vector<uint8_t> buffer;
+
+    if (this->onHeap == true)
+    {
+        buffer.swap(this->heapPayload);
+        this->onHeap = false;
+    }
+    this->inlineSize = 0;
+    return buffer;
+}
@@ -0,0 +1,154 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef TELEGRAM_H
+#define TELEGRAM_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+class TelegramBufferPool;
+
+/** A received telegram with its message type and receive time.
+ *
+ *  Payloads up to inlineCapacity bytes, e.g. the replies to Remote2 commands, are stored in the object
+ *  itself without allocating memory. Larger payloads, e.g. file chunks, are stored in a buffer on the
+ *  heap, which is taken from the TelegramBufferPool of the connection if possible.
+ *
+ *  An empty telegram is used to release waiting threads.
+ */
+class Telegram
+{
+public:
+
+    static constexpr size_t inlineCapacity = 64;
+
+    /** Constructs an empty telegram. */
+    Telegram();
+
+    /** Constructs a telegram with a copy of the payload.
+     *
+     * \param messageType The message type of the telegram.
+     * \param payload The payload to copy.
+     * \param size The size of the payload.
+     * \param pool The pool for the buffer of a large payload, nullptr to allocate it.
+     * \param receiveTime The time at which the telegram was received.
+     */
+    Telegram(int messageType, const uint8_t *payload, size_t size, TelegramBufferPool *pool = nullptr,
+             std::chrono::steady_clock::time_point receiveTime = std::chrono::steady_clock::time_point());
+
+    /** Constructs a telegram which takes over the buffer.
+     *
+     *  Not explicit, so byte arrays can still be put into the queues directly.
+     *
+     * \param payload The payload, which is moved into the telegram.
+     * \param messageType The message type of the telegram.
+     */
+    Telegram(std::vector<uint8_t> &&payload, int messageType = -1);
+
+    /** Returns the message type, -1 if it is unknown. */
+    int getMessageType() const
+    {
+        return this->messageType;
+    }
+
+    /** Returns the time at which the telegram was received, measured with the steady clock. */
+    std::chrono::steady_clock::time_point getReceiveTime() const
+    {
+        return this->receiveTime;
+    }
+
+    const uint8_t* data() const
+    {
+        return this->onHeap ? this->heapPayload.data() : this->inlinePayload.data();
+    }
+
+    size_t size() const
+    {
+        return this->onHeap ? this->heapPayload.size() : this->inlineSize;
+    }
+
+    bool empty() const
+    {
+        return this->size() == 0;
+    }
+
+    uint8_t operator[](size_t index) const
+    {
+        return this->data()[index];
+    }
+
+    /** Returns true if the payload is stored in the object itself. */
+    bool isInline() const
+    {
+        return this->onHeap == false;
+    }
+
+    /** Returns the payload as characters, valid as long as the telegram is not changed. */
+    std::string_view view() const
+    {
+        return std::string_view(reinterpret_cast<const char *>(this->data()), this->size());
+    }
+
+    /** Returns the payload as bytes, valid as long as the telegram is not changed. */
+    std::span<const uint8_t> span() const
+    {
+        return std::span<const uint8_t>(this->data(), this->size());
+    }
+
+    /** Moves the payload into a vector.
+     *
+     *  A buffer on the heap is moved, an inline payload is copied into a buffer of the pool.
+     *  The telegram is empty afterwards.
+     *
+     * \param pool The pool for the buffer of an inline payload, nullptr to allocate it.
+     * \return The payload.
+     */
+    std::vector<uint8_t> toVector(TelegramBufferPool *pool = nullptr);
+
+    /** Takes the buffer of a large payload, e.g. to return it to the pool.
+     *
+     *  The telegram is empty afterwards.
+     *
+     * \return The buffer or an empty vector if the payload is inline.
+     */
+    std::vector<uint8_t> releaseBuffer();
+
+private:
+
+    std::array<uint8_t, inlineCapacity> inlinePayload;
+    std::vector<uint8_t> heapPayload;
+    size_t inlineSize;
+    bool onHeap;
+    int messageType;
+    std::chrono::steady_clock::time_point receiveTime;
+};
+
+#endif // TELEGRAM_H
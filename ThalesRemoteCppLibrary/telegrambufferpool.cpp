@@ -0,0 +1,96 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "telegrambufferpool.h"
+
+#include <algorithm>
+
+TelegramBufferPool::TelegramBufferPool(size_t buffersPerSizeClass) :
+    buffersPerSizeClass(buffersPerSizeClass),
+    allocationCount(0)
+{
+    for (auto &buffers : this->freeBuffers)
+    {
+        buffers.reserve(buffersPerSizeClass);
+    }
+}
+
+std::vector<uint8_t> TelegramBufferPool::acquire(size_t size)
+{
+    auto sizeClass = std::lower_bound(sizeClasses.begin(), sizeClasses.end(), size);
+
+    if (sizeClass == sizeClasses.end())
+    {
+        // Larger than any telegram, is not pooled.
+        std::vector<uint8_t> buffer;
+        buffer.reserve(size);
+        return buffer;
+    }
+
+    auto &buffers = this->freeBuffers[sizeClass - sizeClasses.begin()];
+
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+
+        if (buffers.empty() == false)
+        {
+            std::vector<uint8_t> buffer = std::move(buffers.back());
+            buffers.pop_back();
+            return buffer;
+        }
+        this->allocationCount++;
+    }
+
+    std::vector<uint8_t> buffer;
+    buffer.reserve(*sizeClass);
+    return buffer;
+}
+
+void TelegramBufferPool::release(std::vector<uint8_t> &&buffer)
+{
+    // The buffer belongs to the largest size class which it can hold.
+    auto sizeClass = std::upper_bound(sizeClasses.begin(), sizeClasses.end(), buffer.capacity());
+
+    if (sizeClass == sizeClasses.begin())
+    {
+        return;
+    }
+
+    auto &buffers = this->freeBuffers[sizeClass - sizeClasses.begin() - 1];
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    if (buffers.size() < this->buffersPerSizeClass)
+    {
+        buffer.clear();
+        buffers.push_back(std::move(buffer));
+    }
+}
+
+unsigned long TelegramBufferPool::getAllocationCount() const
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->allocationCount;
+}
@@ -0,0 +1,83 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef TELEGRAMBUFFERPOOL_H
+#define TELEGRAMBUFFERPOOL_H
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/** Pool of reusable buffers for received telegrams.
+ *
+ *  The buffers are sorted into size classes. A buffer taken with acquire has at least the capacity
+ *  of its size class, so filling it does not allocate memory. Buffers returned with release are
+ *  reused by the following telegrams of the same size class.
+ */
+class TelegramBufferPool
+{
+public:
+
+    /** Constructor.
+     *
+     * \param buffersPerSizeClass Maximum number of free buffers kept per size class.
+     */
+    explicit TelegramBufferPool(size_t buffersPerSizeClass = 32);
+    TelegramBufferPool(const TelegramBufferPool &) = delete;
+    TelegramBufferPool& operator=(const TelegramBufferPool &) = delete;
+
+    /** Take an empty buffer for a telegram.
+     *
+     * \param size The size of the telegram.
+     * \return An empty buffer with a capacity of at least size bytes.
+     */
+    std::vector<uint8_t> acquire(size_t size);
+
+    /** Return a buffer for reuse.
+     *
+     *  Buffers which are too small or which do not fit into the pool are freed.
+     *
+     * \param buffer The buffer, which is moved into the pool.
+     */
+    void release(std::vector<uint8_t> &&buffer);
+
+    /** Returns the number of buffers which had to be allocated because the pool was empty.
+     *
+     * \return Number of allocated buffers.
+     */
+    unsigned long getAllocationCount() const;
+
+protected:
+
+    static constexpr std::array<size_t, 6> sizeClasses = {64, 256, 1024, 4096, 16384, 65536};
+
+    mutable std::mutex mutex;
+    std::array<std::vector<std::vector<uint8_t>>, sizeClasses.size()> freeBuffers;
+    size_t buffersPerSizeClass;
+    unsigned long allocationCount;
+};
+
+#endif // TELEGRAMBUFFERPOOL_H
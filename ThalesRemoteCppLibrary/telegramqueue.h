@@ -0,0 +1,199 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef TELEGRAMQUEUE_H
+#define TELEGRAMQUEUE_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <chrono>
+#include <utility>
+
+#include "telegram.h"
+
+/** Interface of the queues which buffer the received telegrams of a channel.
+ *
+ *  Empty elements are used to release waiting threads. They are always added regardless of the capacity.
+ */
+class TelegramQueue
+{
+public:
+
+    /** Behaviour when an element is added to a full queue. */
+    enum class OverflowPolicy
+    {
+        BLOCK,              /**< The writer waits until an element was read. */
+        DROP_OLDEST,        /**< The oldest element is removed from the queue. */
+        DROP_NEWEST,        /**< The new element is discarded. */
+        COALESCE_LATEST     /**< The newest element in the queue is replaced by the new element. */
+    };
+
+    TelegramQueue() = default;
+    TelegramQueue(const TelegramQueue &) = delete ;
+    TelegramQueue& operator=(const TelegramQueue &) = delete ;
+
+    virtual ~TelegramQueue() = default;
+
+    /** Check if the queue is empty.
+     *
+     * @return true if the queue is empty.
+     */
+    virtual bool empty() const = 0;
+
+    /** Returns the number of elements in the queue.
+     *
+     *  The number of byte arrays in the queue.
+     *
+     * @return Number of elements in the queue.
+     */
+    virtual unsigned long size() const = 0;
+
+    /** Adding an element to the queue.
+     *
+     * @param item The element to add.
+     */
+    void put(const Telegram &item)
+    {
+        put(Telegram(item));
+    }
+
+    /** Moving an element into the queue.
+     *
+     * @param item The element to add.
+     */
+    virtual void put(Telegram &&item) = 0;
+
+    /** Adding an element to the queue without waiting.
+     *
+     *  Like put, but if the queue is full and the policy is BLOCK, the element is not added.
+     *
+     * @param item The element to add.
+     * @return false if the element was not added because the queue is full.
+     */
+    bool tryPut(const Telegram &item)
+    {
+        Telegram copy(item);
+        return tryPut(std::move(copy));
+    }
+
+    /** Moving an element into the queue without waiting.
+     *
+     *  The element is only moved if it was added.
+     *
+     * @param item The element to add.
+     * @return false if the element was not added because the queue is full.
+     */
+    virtual bool tryPut(Telegram &&item) = 0;
+
+    /** Waits until the queue is not full.
+     *
+     *  Only the policy BLOCK can fill the queue, with the other policies the method returns immediately.
+     *
+     * @return false if the wait was interrupted.
+     */
+    virtual bool waitForSpace() = 0;
+
+    /** Interrupt writers waiting for space.
+     *
+     *  While interrupted, elements which do not fit into a full queue with the policy BLOCK are discarded
+     *  instead of waiting. This is used to stop the receiving thread of a connection.
+     *
+     * @param interrupted true to interrupt, false to wait again.
+     */
+    virtual void setInterrupted(bool interrupted) = 0;
+
+    /** Set the capacity and the overflow policy.
+     *
+     *  If the queue contains more elements than the new capacity, the oldest elements are discarded.
+     *
+     * @param capacity Maximum number of elements, 0 for unlimited.
+     * @param overflowPolicy Behaviour when an element is added to a full queue.
+     */
+    virtual void setCapacity(size_t capacity, OverflowPolicy overflowPolicy) = 0;
+
+    /** Returns the capacity of the queue.
+     *
+     * @return Maximum number of elements, 0 for unlimited.
+     */
+    virtual size_t getCapacity() const = 0;
+
+    /** Returns the overflow policy of the queue.
+     *
+     * @return The overflow policy.
+     */
+    virtual OverflowPolicy getOverflowPolicy() const = 0;
+
+    /** Returns the number of elements which were discarded because the queue was full.
+     *
+     * @return Number of discarded elements.
+     */
+    virtual unsigned long getDroppedCount() const = 0;
+
+    /** Check if only one thread may read the queue at the same time.
+     *
+     * @return true if concurrent readers are not supported.
+     */
+    virtual bool isSingleReader() const
+    {
+        return false;
+    }
+
+    /** Non-blocking read from the queue.
+     *
+     * If the queue is empty, a vector with length 0 is returned.
+     *
+     * @return An element of the queue.
+     */
+    virtual Telegram pop() = 0;
+
+    /** Blocking and non-blocking read from the queue.
+     *
+     * If blocking is false the pop method is executed.
+     * If blocking is true it will wait for the timeout time to be read if there are no elements in the queue.
+     * The timeout is measured with the steady clock.
+     * After a timeout a vector with length 0 is returned.
+     *
+     * @param blocking true to wait for timeout time.
+     * @param timeout Time to wairt for data.
+     * @return An element of the queue.
+     */
+    virtual Telegram get(const bool blocking = true, const std::chrono::duration<int, std::milli> timeout = std::chrono::duration<int, std::milli>::max()) = 0;
+
+    /** Blocking read of all available elements.
+     *
+     * Waits like get until an element is available and then moves the available elements into out at once.
+     * An empty element ends the reading. If it is the first element, it is removed and appended to out,
+     * otherwise it remains in the queue for the next read.
+     *
+     * @param out The elements are appended to this vector.
+     * @param maxCount Maximum number of elements to read, 0 for unlimited.
+     * @param timeout Time to wait for data.
+     * @return Number of elements appended to out, 0 after a timeout.
+     */
+    virtual size_t drain(std::vector<Telegram> &out, size_t maxCount = 0, const std::chrono::duration<int, std::milli> timeout = std::chrono::duration<int, std::milli>::max()) = 0;
+};
+
+#endif // TELEGRAMQUEUE_H
@@ -0,0 +1,202 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "telegramreactor.h"
+#include "thalesremoteconnection.h"
+#include "termconnectionerror.h"
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <cerrno>
+#endif
+
+TelegramReactor::TelegramReactor(int numberOfThreads) :
+    running(true),
+    nextEventLoop(0)
+{
+#ifdef __linux__
+    for(int i = 0; i < std::max(numberOfThreads, 1); i++)
+    {
+        auto eventLoop = std::make_unique<EventLoop>();
+
+        eventLoop->epoll_handle = epoll_create1(EPOLL_CLOEXEC);
+        eventLoop->wakeup_handle = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+
+        if (eventLoop->epoll_handle < 0 || eventLoop->wakeup_handle < 0)
+        {
+            throw TermConnectionError("Could not create the reactor.");
+        }
+
+        struct epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.ptr = nullptr;
+        epoll_ctl(eventLoop->epoll_handle, EPOLL_CTL_ADD, eventLoop->wakeup_handle, &event);
+
+        eventLoop->thread = new std::thread(&TelegramReactor::eventLoopJob, this, eventLoop.get());
+        this->eventLoops.push_back(std::move(eventLoop));
+    }
+#else
+    (void)numberOfThreads;
+#endif
+}
+
+TelegramReactor::~TelegramReactor()
+{
+#ifdef __linux__
+    this->running = false;
+
+    for(auto &eventLoop : this->eventLoops)
+    {
+        uint64_t wakeup = 1;
+        if (write(eventLoop->wakeup_handle, &wakeup, sizeof(wakeup)) < 0)
+        {
+            // The counter is already set, the thread wakes up anyway.
+        }
+        eventLoop->thread->join();
+        delete eventLoop->thread;
+
+        close(eventLoop->epoll_handle);
+        close(eventLoop->wakeup_handle);
+    }
+#endif
+}
+
+void TelegramReactor::registerConnection(ZenniumConnection* connection)
+{
+#ifdef __linux__
+    EventLoop* eventLoop = this->eventLoops[this->nextEventLoop++ % this->eventLoops.size()].get();
+
+    std::lock_guard<std::recursive_mutex> lock(eventLoop->mutex);
+
+    struct epoll_event event = {};
+    event.events = EPOLLIN | EPOLLRDHUP;
+    event.data.ptr = connection;
+
+    if (epoll_ctl(eventLoop->epoll_handle, EPOLL_CTL_ADD, connection->socket_handle, &event) < 0)
+    {
+        throw TermConnectionError("Could not add the connection to the reactor.");
+    }
+
+    eventLoop->connections.insert(connection);
+#else
+    (void)connection;
+    throw TermConnectionError("The TelegramReactor is only available on Linux.");
+#endif
+}
+
+bool TelegramReactor::unregisterConnection(ZenniumConnection* connection)
+{
+    bool wasRegistered = false;
+
+#ifdef __linux__
+    for(auto &eventLoop : this->eventLoops)
+    {
+        std::lock_guard<std::recursive_mutex> lock(eventLoop->mutex);
+
+        if (eventLoop->connections.erase(connection) > 0)
+        {
+            epoll_ctl(eventLoop->epoll_handle, EPOLL_CTL_DEL, connection->socket_handle, nullptr);
+            wasRegistered = true;
+        }
+    }
+#else
+    (void)connection;
+#endif
+
+    return wasRegistered;
+}
+
+void TelegramReactor::eventLoopJob(EventLoop* eventLoop)
+{
+#ifdef __linux__
+    constexpr int maximumEvents = 64;
+    struct epoll_event events[maximumEvents];
+    std::vector<std::function<void()>> callbacks;
+
+    while (this->running == true)
+    {
+        int numberOfEvents = epoll_wait(eventLoop->epoll_handle, events, maximumEvents, -1);
+
+        if (numberOfEvents < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            break;
+        }
+
+        {
+            std::lock_guard<std::recursive_mutex> lock(eventLoop->mutex);
+            ZenniumConnection::deferredCallbacks = &callbacks;
+
+            for (int i = 0; i < numberOfEvents; i++)
+            {
+                auto connection = static_cast<ZenniumConnection*>(events[i].data.ptr);
+
+                if (connection == nullptr)
+                {
+                    uint64_t wakeup;
+                    if (read(eventLoop->wakeup_handle, &wakeup, sizeof(wakeup)) < 0)
+                    {
+                        // Nothing to read, another thread has already reset the counter.
+                    }
+                    continue;
+                }
+
+                /*
+                 * The connection may have been removed between epoll_wait and locking the mutex.
+                 */
+                if (eventLoop->connections.count(connection) == 0)
+                {
+                    continue;
+                }
+
+                if (connection->receiveAvailableTelegrams() == false)
+                {
+                    epoll_ctl(eventLoop->epoll_handle, EPOLL_CTL_DEL, connection->socket_handle, nullptr);
+                    eventLoop->connections.erase(connection);
+                    connection->releaseWaitingReceivers();
+                }
+            }
+
+            ZenniumConnection::deferredCallbacks = nullptr;
+        }
+
+        /*
+         * Callbacks without executor are called without the lock, so they can use the connection,
+         * e.g. send the next command, without blocking the other connections of the event loop.
+         */
+        for (auto &callback : callbacks)
+        {
+            callback();
+        }
+        callbacks.clear();
+    }
+#else
+    (void)eventLoop;
+#endif
+}
@@ -0,0 +1,109 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef TELEGRAMREACTOR_H
+#define TELEGRAMREACTOR_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+class ZenniumConnection;
+
+/** Class which receives the telegrams of many connections with a fixed number of threads.
+ *
+ *  By default, each ZenniumConnection starts its own thread which blocks while reading from the socket.
+ *  If many connections are used in one process, the connections can instead be served by a reactor.
+ *  The sockets of all registered connections are monitored with epoll by a small, fixed number of threads.
+ *  The received telegrams are put into the queues of the connections as with the receive thread.
+ *
+ *  The reactor is passed to the constructor of the ZenniumConnection and must exist longer than all
+ *  connections which use it.
+ *
+ *  The threads of the reactor never wait for the application. Therefore the queues of the connections
+ *  cannot use the overflow policy TelegramQueue::OverflowPolicy::BLOCK with a capacity.
+ *  Reply callbacks and subscription handlers without executor are called by the thread of the reactor
+ *  after it has released the lock of its connections. They can use the connection, but a long running
+ *  callback still delays the other connections of the same thread.
+ *
+ *  \warning The reactor is only available on Linux. On other platforms registering a connection
+ *           throws a TermConnectionError exception.
+ */
+class TelegramReactor
+{
+public:
+
+    /** Constructor.
+     *
+     * \param numberOfThreads Number of threads that serve the connections. The connections are distributed to the threads.
+     */
+    explicit TelegramReactor(int numberOfThreads = 1);
+    TelegramReactor(const TelegramReactor &) = delete;
+    TelegramReactor& operator=(const TelegramReactor &) = delete;
+
+    /** Destructor. Stops all threads of the reactor. */
+    ~TelegramReactor();
+
+    /** Add a connected connection to the reactor.
+     *
+     *  Called by the ZenniumConnection when the connection to Term is established.
+     *
+     * \param connection The connection whose socket is monitored.
+     */
+    void registerConnection(ZenniumConnection* connection);
+
+    /** Remove a connection from the reactor.
+     *
+     *  After this method returns, no more telegrams are read for this connection.
+     *
+     * \param connection The connection to remove.
+     * \return true if the connection was still registered.
+     */
+    bool unregisterConnection(ZenniumConnection* connection);
+
+protected:
+
+    class EventLoop
+    {
+    public:
+        int epoll_handle;
+        int wakeup_handle;
+        std::thread *thread;
+        std::recursive_mutex mutex;
+        std::unordered_set<ZenniumConnection*> connections;
+    };
+
+    std::vector<std::unique_ptr<EventLoop>> eventLoops;
+    std::atomic<bool> running;
+    std::atomic<size_t> nextEventLoop;
+
+    /** The method running in the threads of the reactor, reading the sockets which are ready. */
+    void eventLoopJob(EventLoop* eventLoop);
+};
+
+#endif // TELEGRAMREACTOR_H
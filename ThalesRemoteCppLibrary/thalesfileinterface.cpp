@@ -24,6 +24,7 @@
  * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 #include "thalesfileinterface.h"
+#include "termconnectionerror.h"
 #include <iostream>
 #include <filesystem>
 #include <iostream>
@@ -39,6 +40,9 @@ ThalesFileInterface::ThalesFileInterface(std::string address, std::string connec
     this->saveReceivedFilesToDisk = false;
     this->keepReceivedFilesInObject = false;
     this->receiving_worker_is_running = false;
+    this->nextFileChunk = 0;
+    this->fileLength = -1;
+    this->fileIsInProgress = false;
 }
 
 ThalesFileInterface::ThalesFileInterface(ZenniumConnection* connection)
@@ -49,6 +53,9 @@ ThalesFileInterface::ThalesFileInterface(ZenniumConnection* connection)
     this->saveReceivedFilesToDisk = false;
     this->keepReceivedFilesInObject = false;
     this->receiving_worker_is_running = false;
+    this->nextFileChunk = 0;
+    this->fileLength = -1;
+    this->fileIsInProgress = false;
 }
 
 void ThalesFileInterface::close()
@@ -81,7 +88,13 @@ std::string ThalesFileInterface::enableAutomaticFileExchange(bool enable, std::s
                     std::chrono::duration<int, std::milli>::max(),
                     132
                     );
-        std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+        {
+            // A file which is just being transferred is still received.
+            std::unique_lock<std::mutex> lock(this->fileInProgressMutex);
+            this->fileCompleted.wait_for(lock, std::chrono::milliseconds(1000), [this]() {
+                return this->fileIsInProgress == false;
+            });
+        }
         this->stoppWorker();
 
     }
@@ -176,28 +189,49 @@ ThalesFileInterface::FileObject ThalesFileInterface::receiveFile(const std::chro
     retval.name = "";
     std::string filePath;
 
+    // The timeout applies to the whole file, each step waits only for the remaining time.
+    const auto deadline = ZenniumConnection::deadlineAfter(timeout);
+
     try {
         filePath = this->remoteConnection->waitForStringTelegram(130,timeout);
     }  catch (...) {
         return retval;
     }
 
-    std::string fileLength = this->remoteConnection->waitForStringTelegram(129);
-    std::stringstream converterStream(fileLength);
-    int fileLengthBytes;
-    converterStream >> fileLengthBytes;
+    std::string fileLength = this->remoteConnection->waitForStringTelegram(129, ZenniumConnection::timeUntil(deadline));
+    long fileLengthBytes = parseFileLength(fileLength);
+    if(fileLengthBytes < 0)
+    {
+        throw TermConnectionError("Invalid file length received: " + fileLength);
+    }
 
-    int bytesToReceive = fileLengthBytes;
+    long bytesToReceive = fileLengthBytes;
 
     std::vector<uint8_t> fileData;
+    fileData.reserve(static_cast<size_t>(fileLengthBytes));
     while(bytesToReceive > 0)
     {
-        auto readBytes = this->remoteConnection->waitForTelegram(131);
-        fileData.insert(fileData.end(),readBytes.begin(),readBytes.end());
-        bytesToReceive -= readBytes.size();
+        /*
+         * All queued data telegrams are read at once. Telegrams after the end of the
+         * file belong to the following file and are kept for the next call.
+         */
+        if(this->nextFileChunk == this->fileChunks.size())
+        {
+            this->fileChunks.clear();
+            this->nextFileChunk = 0;
+            if(this->remoteConnection->drain(131, this->fileChunks, 0, ZenniumConnection::timeUntil(deadline)) == 0)
+            {
+                throw TermConnectionError("Timeout while waiting for the file data.");
+            }
+        }
+
+        auto &readBytes = this->fileChunks[this->nextFileChunk++];
+        fileData.insert(fileData.end(),readBytes.data(),readBytes.data() + readBytes.size());
+        bytesToReceive -= static_cast<long>(readBytes.size());
+        this->remoteConnection->releaseTelegram(std::move(readBytes));
     }
 
-    retval.binary_data = fileData;
+    retval.binary_data = std::move(fileData);
     retval.path = filePath;
     retval.name = std::filesystem::path(filePath).filename().string();
     return retval;
@@ -208,7 +242,23 @@ void ThalesFileInterface::startWorker()
     if(this->receiving_worker_is_running == false)
     {
         this->receiving_worker_is_running = true;
-        this->receivingWorker = new std::thread(&ThalesFileInterface::fileReceiverJob, this);
+        if(this->fileExecutor == nullptr)
+        {
+            this->fileExecutor = std::make_unique<ThreadPoolExecutor>();
+        }
+
+        /*
+         * The handlers post the telegrams themselves instead of passing the executor to subscribe.
+         * Telegrams that were posted before the subscriptions are cancelled are then still processed.
+         */
+        for(int channel : {130, 129, 131})
+        {
+            this->subscriptionIds.push_back(this->remoteConnection->subscribe(channel, [this, channel](const std::vector<uint8_t> &telegram, std::exception_ptr error) {
+                this->fileExecutor->post([this, channel, telegram, error]() {
+                    this->fileTelegramReceived(channel, telegram, error);
+                });
+            }));
+        }
     }
 }
 
@@ -217,33 +267,103 @@ void ThalesFileInterface::stoppWorker()
     if(this->receiving_worker_is_running == true)
     {
         this->receiving_worker_is_running = false;
-        this->receivingWorker->join();
-        delete this->receivingWorker;
+        for(int id : this->subscriptionIds)
+        {
+            this->remoteConnection->unsubscribe(id);
+        }
+        this->subscriptionIds.clear();
+
+        // The executor has one thread, so all telegrams posted before are processed after this task.
+        std::promise<void> processed;
+        this->fileExecutor->post([&processed]() {
+            processed.set_value();
+        });
+        processed.get_future().wait();
+
+        std::lock_guard<std::mutex> lock(this->fileInProgressMutex);
+        this->fileIsInProgress = false;
     }
 }
 
-void ThalesFileInterface::fileReceiverJob()
+void ThalesFileInterface::fileTelegramReceived(int message_type, const std::vector<uint8_t> &telegram, std::exception_ptr error)
 {
-    while (this->receiving_worker_is_running == true)
+    std::unique_lock<std::mutex> lock(this->fileInProgressMutex);
+
+    if(error)
     {
-        try {
-            auto file = this->receiveFile(std::chrono::milliseconds(1000));
-            if(file.name != "")
-            {
-                if(std::find(filesToSkip.begin(),filesToSkip.end(),file.name) == filesToSkip.end())
-                {
-                    if(saveReceivedFilesToDisk == true)
-                    {
-                        this->saveReceivedFile(file);
-                    }
-                    if(keepReceivedFilesInObject == true)
-                    {
-                        this->receivedFiles.push_back(file);
-                    }
-                }
-            }
-        }  catch (...) {
-            this->receiving_worker_is_running = false;
+        this->fileIsInProgress = false;
+        lock.unlock();
+        this->fileCompleted.notify_all();
+        return;
+    }
+
+    if(message_type == 130)
+    {
+        std::string filePath(telegram.begin(), telegram.end());
+        this->fileInProgress = FileObject();
+        this->fileInProgress.path = filePath;
+        this->fileInProgress.name = std::filesystem::path(filePath).filename().string();
+        this->fileLength = -1;
+        this->fileIsInProgress = true;
+        return;
+    }
+    else if(this->fileIsInProgress == false)
+    {
+        return;
+    }
+    else if(message_type == 129)
+    {
+        this->fileLength = parseFileLength(std::string(telegram.begin(), telegram.end()));
+        if(this->fileLength < 0)
+        {
+            // Without a valid length the end of the file is unknown, the transfer is discarded.
+            this->fileInProgress = FileObject();
+            this->fileIsInProgress = false;
+            lock.unlock();
+            this->fileCompleted.notify_all();
+            return;
+        }
+    }
+    else if(message_type == 131)
+    {
+        this->fileInProgress.binary_data.insert(this->fileInProgress.binary_data.end(), telegram.begin(), telegram.end());
+    }
+
+    if(this->fileLength >= 0 && this->fileInProgress.binary_data.size() >= static_cast<size_t>(this->fileLength))
+    {
+        FileObject file = std::move(this->fileInProgress);
+        this->fileIsInProgress = false;
+        lock.unlock();
+        this->fileCompleted.notify_all();
+
+        this->fileReceived(file);
+    }
+}
+
+long ThalesFileInterface::parseFileLength(const std::string &fileLength)
+{
+    std::stringstream converterStream(fileLength);
+    long fileLengthBytes;
+    converterStream >> fileLengthBytes;
+
+    if(converterStream.fail() || fileLengthBytes < 0)
+    {
+        return -1;
+    }
+    return fileLengthBytes;
+}
+
+void ThalesFileInterface::fileReceived(const FileObject &file)
+{
+    if(std::find(filesToSkip.begin(),filesToSkip.end(),file.name) == filesToSkip.end())
+    {
+        if(saveReceivedFilesToDisk == true)
+        {
+            this->saveReceivedFile(file);
+        }
+        if(keepReceivedFilesInObject == true)
+        {
+            this->receivedFiles.push_back(file);
         }
     }
 }
@@ -26,6 +26,7 @@
 #ifndef THALESFILEINTERFACE_H
 #define THALESFILEINTERFACE_H
 
+#include <memory>
 #include <string>
 #include <vector>
 #include "thalesremoteconnection.h"
@@ -174,30 +175,57 @@ public:
 private:
     /** Receive a file via the interface.
      *
+     * \param timeout Timeout for the whole file, i.e. the path, the length and all data telegrams.
      */
     FileObject receiveFile(const std::chrono::duration<int, std::milli> timeout = std::chrono::duration<int, std::milli>::max());
 
-    /** Start the receive thread.
+    /** Subscribe to the file channels to receive the files automatically.
      *
+     *  The executor which assembles the files is created with the first call.
      */
     void startWorker();
 
-    /** Stop receiving thread.
+    /** Cancel the subscriptions and wait until the received telegrams are processed.
      *
+     *  Telegrams which were received before the subscriptions were cancelled are still processed.
      */
     void stoppWorker();
 
-    /** Function which is executed as receive thread.
+    /** Assembles the files from the telegrams of the subscribed channels.
      *
+     *  Channel 130 starts a file with its path, channel 129 contains the length and channel 131 the data.
+     *  The file is complete when the data of the length was received. If the length is invalid the file is discarded.
      */
-    void fileReceiverJob();
+    void fileTelegramReceived(int message_type, const std::vector<uint8_t> &telegram, std::exception_ptr error);
+
+    /** Converts the length of channel 129.
+     *
+     * \return The length or -1 if the text is not a valid length.
+     */
+    static long parseFileLength(const std::string &fileLength);
+
+    /** Skips, saves or keeps a completely received file.
+     *
+     */
+    void fileReceived(const FileObject &file);
 
 
     std::string connectionName;
     ZenniumConnection * remoteConnection;
 
     bool receiving_worker_is_running;
-    std::thread *receivingWorker;
+    std::vector<int> subscriptionIds;
+
+    /** Telegrams of channel 131 read by receiveFile which belong to the following file. */
+    std::vector<Telegram> fileChunks;
+    size_t nextFileChunk;
+
+    FileObject fileInProgress;
+    /** Length of the file in progress, -1 until channel 129 was received. */
+    long fileLength;
+    bool fileIsInProgress;
+    std::mutex fileInProgressMutex;
+    std::condition_variable fileCompleted;
 
     bool automaticFileExchange;
     std::vector<std::string>filesToSkip;
@@ -205,6 +233,9 @@ private:
     std::string pathToSave;
     bool saveReceivedFilesToDisk;
     bool keepReceivedFilesInObject;
+
+    /** Declared last, so it is destroyed and finishes its tasks before the other members. */
+    std::unique_ptr<ThreadPoolExecutor> fileExecutor;
 };
 
 #endif // THALESFILEINTERFACE_H
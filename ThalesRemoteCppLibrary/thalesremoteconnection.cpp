@@ -26,20 +26,55 @@
 
 #include "thalesremoteconnection.h"
 #include "termconnectionerror.h"
+#include "telegramreactor.h"
+#include <cerrno>
+
+/** Size of the receive buffer. A telegram with the maximum length of 65535 bytes plus header fits completely. */
+static const size_t receiveBufferSize = 0x20000;
+static const size_t sendQueueReserve = 0x10000;
+static const size_t maximumSendQueueSize = 0x10000;
+
+thread_local std::vector<std::function<void()>>* ZenniumConnection::deferredCallbacks = nullptr;
 
 ZenniumConnection::ZenniumConnection() :
+    ZenniumConnection(nullptr)
+{
+
+}
+
+ZenniumConnection::ZenniumConnection(TelegramReactor* reactor) :
 
     defaultTimeout(std::chrono::duration<int, std::milli>::max()),
+    connectionCount(0),
     socket_handle(INVALID_SOCKET),
+    pendingRepliesCount(0),
+    pipelineDepth(1),
+    acceptingReplies(false),
+    callbackExecutor(nullptr),
+    nextSubscriptionId(1),
+    queuedRequestsForChannels(),
+    sendQueueEnabled(false),
+    sendQueueRunning(false),
+    sendQueueBusy(false),
+    sendQueueFailed(false),
+    sendWorker(nullptr),
+    anyTelegramWaiters(0),
+    anyTelegramSequence(0),
     receiving_worker_is_running(false),
-    receivingWorker(nullptr)
+    receivingWorker(nullptr),
+    inlineReceive(false),
+    reactor(reactor),
+    receiveBufferStart(0),
+    receiveBufferFill(0)
 {
-    this->availableChannels = {2,128,129,130,131,132};
+    for(auto &queue : this->channelTable)
+    {
+        queue = nullptr;
+    }
 
-    for(int channel : this->availableChannels)
+    for(int channel : {2,128,129,130,131,132})
     {
-        std::shared_ptr<ThreadsafeQueue> p = std::make_shared<ThreadsafeQueue>();
-        this->queuesForChannels.insert({channel, p});
+        this->registerChannel(channel);
     }
 
 #ifdef _WIN32
@@ -51,6 +86,12 @@ ZenniumConnection::ZenniumConnection() :
 
 ZenniumConnection::~ZenniumConnection()
 {
+    if(this->reactor != nullptr)
+    {
+        this->reactor->unregisterConnection(this);
+    }
+
+    this->disableSendQueue();
 
 #ifdef _WIN32
     WSACleanup();
@@ -62,82 +103,56 @@ bool ZenniumConnection::connectToTerm(std::string address, std::string connectio
 {
     std::this_thread::sleep_for(std::chrono::milliseconds(400));
 
-    this->socket_handle = socket(AF_INET, SOCK_STREAM, 0);
     this->connectionName = connectionName;
+    this->openSocket(address, std::chrono::duration<int, std::milli>::max());
 
-#ifdef _WIN32
-    if (this->socket_handle == INVALID_SOCKET) {
-#else
-    if (this->socket_handle < 0) {
-#endif
+    this->startTelegramListener();
 
-        throw TermConnectionError("Could not create socket");
-        return false;
-    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(400));
 
-    struct addrinfo hints = {};
-    struct addrinfo *result_pointer;
+    this->sendRegistrationPacket();
 
-    hints.ai_family = AF_INET;
-    hints.ai_socktype = SOCK_STREAM;
-    hints.ai_protocol = IPPROTO_TCP;
+    std::this_thread::sleep_for(std::chrono::milliseconds(800));
 
-    if (getaddrinfo(address.data(), "260", &hints, &result_pointer) != 0)
-    {
-        this->closeSocket();
-        throw TermConnectionError("Error while resolving address");
-        return false;
-    }
+    this->connectionCount++;
+    return true;
+}
 
-    struct addrinfo *first_addr = result_pointer;
+bool ZenniumConnection::connectToTerm(std::string address, std::string connectionName, const std::chrono::duration<int, std::milli> timeout)
+{
+    const auto deadline = deadlineAfter(timeout);
 
-    if (first_addr == nullptr)
+    this->connectionName = connectionName;
+    this->openSocket(address, timeout);
+
+    this->startTelegramListener();
+
+    try
     {
-        freeaddrinfo(result_pointer);
-        this->closeSocket();
-        throw TermConnectionError("Could not resolve hostname");
-        return false;
+        this->sendRegistrationPacket();
+
+        /*
+         * Term does not acknowledge the registration packet itself.
+         * The first HeartBeat reply shows that the registration was processed and the connection can be used.
+         * No other request can wait yet, so the reply is taken without correlation key.
+         */
+        this->sendTelegramWithReplyToken("1," + this->connectionName, 128, 128).getString(timeUntil(deadline));
     }
-
-    if (connect(this->socket_handle, first_addr->ai_addr, static_cast<int>(first_addr->ai_addrlen)) < 0)
+    catch (const TermConnectionError &)
     {
+        this->stopTelegramListener();
         this->closeSocket();
-        throw TermConnectionError("Could not connect to term");
-        return false;
+        throw TermConnectionError("Term did not confirm the registration within " + std::to_string(timeout.count()) + " ms.");
     }
 
-    this->startTelegramListener();
-
-    std::this_thread::sleep_for(std::chrono::milliseconds(400));
-
-    unsigned short payload_length = static_cast<unsigned short>(connectionName.length());
-
-    std::vector<unsigned char> registration_packet;
-
-    registration_packet.reserve(payload_length + 6);
-
-    registration_packet.push_back(reinterpret_cast<unsigned char *>(&payload_length)[1]);
-    registration_packet.push_back(reinterpret_cast<unsigned char *>(&payload_length)[0]);
-
-    const std::vector<unsigned char> fixedHeaderBytes =
-    {
-        0x12, 0xd0,
-        0xff, 0xff,
-        0xff, 0xff
-    };
-
-    registration_packet.insert(registration_packet.end(), fixedHeaderBytes.begin(), fixedHeaderBytes.end());
-
-    std::copy(connectionName.begin(), connectionName.end(), std::back_inserter(registration_packet));
-    sendall(this->socket_handle, reinterpret_cast<char *>(registration_packet.data()), static_cast<int>(registration_packet.size()), 0);
-
-    std::this_thread::sleep_for(std::chrono::milliseconds(800));
-
+    this->connectionCount++;
     return true;
 }
 
 void ZenniumConnection::disconnectFromTerm()
 {
+    // Telegrams which do not fit into full queues are discarded, so the replies can be received.
+    this->setQueuesInterrupted(true);
 
     try
     {
@@ -151,6 +166,11 @@ void ZenniumConnection::disconnectFromTerm()
     this->closeSocket();
 }
 
+unsigned long ZenniumConnection::getConnectionCount() const
+{
+    return this->connectionCount;
+}
+
 bool ZenniumConnection::isConnectedToTerm() const
 {
 
@@ -186,28 +206,64 @@ int ZenniumConnection::sendall(SOCKET s, char *data, int dataSize, int flags)
     return (n==-1) ? -1 : totalSent; // Return -1 on error, otherwise return the number of bytes sent
 }
 
-void ZenniumConnection::sendTelegram(std::string payload, int message_type)
+void ZenniumConnection::sendTelegram(const std::string &payload, int message_type)
 {
-    std::vector<unsigned char> bytes(payload.begin(), payload.end());
-    this->sendTelegram(bytes, message_type);
+    this->sendTelegram(std::string_view(payload), message_type);
 }
 
-void ZenniumConnection::sendTelegram(std::vector<unsigned char> payload, int message_type)
+void ZenniumConnection::sendTelegram(const char *payload, int message_type)
 {
+    this->sendTelegram(std::string_view(payload), message_type);
+}
 
-    std::vector<unsigned char> packet;
-    uint16_t payload_length = static_cast<uint16_t>(payload.size());
+void ZenniumConnection::sendTelegram(std::string_view payload, int message_type)
+{
+    this->sendTelegram(std::as_bytes(std::span<const char>(payload.data(), payload.size())), message_type);
+}
 
-    packet.reserve(payload_length + 3);
-    packet.push_back(reinterpret_cast<unsigned char *>(&payload_length)[0]);
-    packet.push_back(reinterpret_cast<unsigned char *>(&payload_length)[1]);
-    packet.push_back(message_type);
+void ZenniumConnection::sendTelegram(const std::vector<unsigned char> &payload, int message_type)
+{
+    this->sendTelegram(std::as_bytes(std::span<const unsigned char>(payload)), message_type);
+}
 
-    packet.insert(packet.end(), payload.begin(), payload.end());
+void ZenniumConnection::sendTelegram(std::span<const std::byte> payload, int message_type, SendPriority priority)
+{
+    /*
+     * The send mutex is only taken to write directly. A thread waiting for space in the send queue
+     * holds no lock which an urgent telegram needs.
+     */
+    while(this->queueTelegram(payload, message_type, priority) == false)
+    {
+        std::lock_guard<std::mutex> lock(this->sendMutex);
+        if(this->sendQueueEnabled == false)
+        {
+            this->writeTelegram(payload, message_type);
+            return;
+        }
+    }
+}
 
-    int status = sendall(this->socket_handle, reinterpret_cast<char *>(packet.data()), static_cast<int>(packet.size()), 0);
+void ZenniumConnection::writeTelegram(std::span<const std::byte> payload, int message_type)
+{
+    if(payload.size() > 0xFFFF)
+    {
+        throw TermConnectionError("The payload of a telegram can be at most 65535 bytes long.");
+    }
 
-    if(status == -1)
+    const char header[3] =
+    {
+        static_cast<char>(payload.size() & 0xFF),
+        static_cast<char>((payload.size() >> 8) & 0xFF),
+        static_cast<char>(message_type)
+    };
+
+    SendBuffer buffers[2] =
+    {
+        {header, sizeof(header)},
+        {reinterpret_cast<const char *>(payload.data()), payload.size()}
+    };
+
+    if(this->sendBuffers(buffers, 2) == false)
     {
         throw TermConnectionError("Socket error during data transmission.");
     }
@@ -225,10 +281,29 @@ std::vector<uint8_t> ZenniumConnection::waitForBinaryTelegram(int message_type)
 
 std::vector<uint8_t> ZenniumConnection::waitForTelegram(int message_type, const std::chrono::duration<int, std::milli> timeout) {
 
-    auto receivedTelegram = this->queuesForChannels[message_type]->get(true, timeout);
+    auto telegram = this->waitForTelegramMessage(message_type, timeout);
+    return telegram.toVector(&this->telegramPool);
+}
+
+Telegram ZenniumConnection::waitForTelegramMessage(int message_type)
+{
+    return this->waitForTelegramMessage(message_type, this->defaultTimeout);
+}
+
+Telegram ZenniumConnection::waitForTelegramMessage(int message_type, const std::chrono::duration<int, std::milli> timeout)
+{
+    auto queue = this->getQueueForChannel(message_type);
+    const auto deadline = deadlineAfter(timeout);
+
+    if(this->inlineReceive == true)
+    {
+        this->waitInline([queue]() { return queue->empty() == false; }, timeout);
+    }
 
+    auto receivedTelegram = queue->get(this->inlineReceive == false, timeUntil(deadline));
 
-    if(receivedTelegram.size() == 0)
+
+    if(receivedTelegram.empty() == true)
     {
         throw TermConnectionError("Empty telegram received.");
     }
@@ -240,6 +315,155 @@ std::vector<uint8_t> ZenniumConnection::waitForBinaryTelegram(int message_type,
     return waitForTelegram(message_type,timeout);
 }
 
+size_t ZenniumConnection::drain(int message_type, std::vector<std::vector<uint8_t>> &telegrams, size_t maxCount)
+{
+    return this->drain(message_type, telegrams, maxCount, this->defaultTimeout);
+}
+
+size_t ZenniumConnection::drain(int message_type, std::vector<std::vector<uint8_t>> &telegrams, size_t maxCount, const std::chrono::duration<int, std::milli> timeout)
+{
+    std::vector<Telegram> receivedTelegrams;
+    size_t count = this->drain(message_type, receivedTelegrams, maxCount, timeout);
+
+    for (auto &telegram : receivedTelegrams)
+    {
+        telegrams.push_back(telegram.toVector(&this->telegramPool));
+    }
+    return count;
+}
+
+size_t ZenniumConnection::drain(int message_type, std::vector<Telegram> &telegrams, size_t maxCount)
+{
+    return this->drain(message_type, telegrams, maxCount, this->defaultTimeout);
+}
+
+size_t ZenniumConnection::drain(int message_type, std::vector<Telegram> &telegrams, size_t maxCount, const std::chrono::duration<int, std::milli> timeout)
+{
+    auto queue = this->getQueueForChannel(message_type);
+    const auto deadline = deadlineAfter(timeout);
+
+    if (this->inlineReceive == true && this->waitInline([queue]() { return queue->empty() == false; }, timeout) == false)
+    {
+        return 0;
+    }
+
+    // In the inline mode no other thread fills the queue, so the telegrams are only taken if available.
+    size_t count = queue->drain(telegrams, maxCount, this->inlineReceive ? std::chrono::duration<int, std::milli>(0) : timeUntil(deadline));
+
+    if (count == 1 && telegrams.back().empty() == true)
+    {
+        telegrams.pop_back();
+        throw TermConnectionError("Empty telegram received.");
+    }
+    return count;
+}
+
+std::tuple<int, Telegram> ZenniumConnection::waitForAny(const std::vector<int> &message_types)
+{
+    return this->waitForAny(message_types, this->defaultTimeout);
+}
+
+std::tuple<int, Telegram> ZenniumConnection::waitForAny(const std::vector<int> &message_types, const std::chrono::duration<int, std::milli> timeout)
+{
+    const auto deadline = deadlineAfter(timeout);
+
+    while (true)
+    {
+        // Looked up for each attempt, because a channel may have been unregistered or its queue replaced.
+        std::vector<TelegramQueue*> queues;
+        for (int message_type : message_types)
+        {
+            queues.push_back(this->getQueueForChannel(message_type));
+            this->checkSharedReading(message_type, queues.back());
+        }
+
+        auto firstAvailable = [&queues]() {
+            return std::find_if(queues.begin(), queues.end(), [](TelegramQueue* queue) { return queue->empty() == false; });
+        };
+
+        if (this->inlineReceive == true)
+        {
+            if (this->waitInline([&]() { return firstAvailable() != queues.end(); }, timeUntil(deadline)) == false)
+            {
+                return {-1, Telegram()};
+            }
+        }
+        else if (this->waitForAnyTelegram([&]() { return firstAvailable() != queues.end(); }, deadline) == false)
+        {
+            return {-1, Telegram()};
+        }
+
+        auto queue = firstAvailable();
+        if (queue == queues.end())
+        {
+            continue;
+        }
+
+        auto telegram = (*queue)->pop();
+        if (telegram.empty() == false)
+        {
+            return {message_types[queue - queues.begin()], std::move(telegram)};
+        }
+
+        std::lock_guard<std::mutex> lock(this->pendingRepliesMutex);
+        if (this->acceptingReplies == false)
+        {
+            throw TermConnectionError("Empty telegram received.");
+        }
+        // Another thread took the telegram or the queue was replaced, so the queues are checked again.
+    }
+}
+
+template <typename Condition>
+bool ZenniumConnection::waitForAnyTelegram(Condition condition, const std::chrono::steady_clock::time_point deadline)
+{
+    std::unique_lock<std::mutex> lock(this->anyTelegramMutex);
+    this->anyTelegramWaiters++;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    bool available = condition();
+    while (available == false)
+    {
+        /*
+         * The sequence is read while the mutex is held, so a telegram put into a queue after the
+         * condition was checked changes the sequence only after this thread waits.
+         */
+        const auto sequence = this->anyTelegramSequence;
+        auto sequenceChanged = [this, sequence]() { return this->anyTelegramSequence != sequence; };
+
+        if (deadline == std::chrono::steady_clock::time_point::max())
+        {
+            this->anyTelegramAvailable.wait(lock, sequenceChanged);
+        }
+        else if (this->anyTelegramAvailable.wait_until(lock, deadline, sequenceChanged) == false)
+        {
+            break;
+        }
+        available = condition();
+    }
+
+    this->anyTelegramWaiters--;
+    return available;
+}
+
+void ZenniumConnection::notifyAnyTelegramWaiters()
+{
+    /*
+     * The waiting threads register before checking the queues,
+     * so either they find the telegram or they are notified.
+     */
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (this->anyTelegramWaiters.load(std::memory_order_relaxed) > 0)
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->anyTelegramMutex);
+            this->anyTelegramSequence++;
+        }
+        this->anyTelegramAvailable.notify_all();
+    }
+}
+
 std::string ZenniumConnection::waitForStringTelegram(int message_type)
 {
     return this->waitForStringTelegram(message_type, this->defaultTimeout);
@@ -248,14 +472,16 @@ std::string ZenniumConnection::waitForStringTelegram(int message_type)
 std::string ZenniumConnection::waitForStringTelegram(int message_type, const std::chrono::duration<int, std::milli> timeout)
 {
 
-    std::vector<uint8_t> telegram = waitForTelegram(message_type, timeout);
+    Telegram telegram = this->waitForTelegramMessage(message_type, timeout);
+    std::string reply(telegram.view());
 
-    return std::string(reinterpret_cast<char *>(telegram.data()), telegram.size());
+    this->telegramPool.release(telegram.releaseBuffer());
+    return reply;
 }
 
 bool ZenniumConnection::isTelegramAvailable(int message_type)
 {
-    auto empty = this->queuesForChannels[message_type]->empty();
+    auto empty = this->getQueueForChannel(message_type)->empty();
     return !empty;
 }
 
@@ -271,132 +497,1264 @@ std::string ZenniumConnection::sendStringAndWaitForReplyString(std::string paylo
 
 std::string ZenniumConnection::sendStringAndWaitForReplyString(std::string payload, int message_type, const std::chrono::duration<int, std::milli> timeout, int answer_message_type)
 {
-    this->sendTelegram(payload, message_type);
-    return this->waitForStringTelegram(answer_message_type, timeout);
+    return this->sendTelegramWithReplyToken(payload, message_type, answer_message_type).getString(timeout);
 }
 
-std::string ZenniumConnection::getConnectionName()
+std::future<std::vector<uint8_t>> ZenniumConnection::sendTelegramWithReply(std::string_view payload, int message_type, int answer_message_type)
 {
-    return this->connectionName;
+    return this->submitRequest(payload, message_type, answer_message_type)->promise.get_future();
 }
 
-void ZenniumConnection::setTimeout(const std::chrono::duration<int, std::milli> timeout)
+ZenniumConnection::ReplyToken ZenniumConnection::sendTelegramWithReplyToken(std::string_view payload, int message_type, int answer_message_type, std::string_view correlationKey, SendPriority priority)
 {
-    this->defaultTimeout = timeout;
+    auto request = std::make_shared<PendingReply>();
+    request->correlationKey = correlationKey;
+
+    return ReplyToken(this, this->submitRequest(payload, message_type, answer_message_type, request, priority));
 }
 
-std::chrono::duration<int, std::milli> ZenniumConnection::getTimeout()
+ZenniumConnection::ReplyToken::ReplyToken(ZenniumConnection* connection, std::shared_ptr<PendingReply> request) :
+    connection(connection),
+    request(request),
+    reply(request->promise.get_future())
 {
-    return this->defaultTimeout;
+
 }
 
-std::tuple<int, std::vector<uint8_t>> ZenniumConnection::readTelegramFromSocket()
+ZenniumConnection::ReplyToken& ZenniumConnection::ReplyToken::operator=(ReplyToken &&other)
 {
-    bool connectionInterrupted = false;
-    std::vector<uint8_t> incoming_packet;
-#ifdef _WIN32
-    int received_bytes;
-    int total_received_bytes = 0;
-#else
-    ssize_t received_bytes;
-    size_t total_received_bytes = 0;
-#endif
+    if (this != &other)
+    {
+        this->cancel();
+        this->connection = other.connection;
+        this->request = std::move(other.request);
+        this->reply = std::move(other.reply);
+    }
+    return *this;
+}
 
-    char header_bytes[3];
-    unsigned short *length_data = reinterpret_cast<unsigned short*>(header_bytes);
+ZenniumConnection::ReplyToken::~ReplyToken()
+{
+    // Otherwise the request keeps its pipeline slot and takes the reply of the next request.
+    this->cancel();
+}
+
+std::vector<uint8_t> ZenniumConnection::ReplyToken::get(const std::chrono::duration<int, std::milli> timeout)
+{
+    // The inline wait and the wait for the future share one deadline.
+    const auto deadline = deadlineAfter(timeout);
 
-    do
+    if (this->connection->inlineReceive == true)
     {
-        received_bytes = recv(this->socket_handle, &header_bytes[total_received_bytes], 3 - total_received_bytes, 0);
+        this->connection->waitInline([this]() { return this->isReady(); }, timeout);
+    }
 
-        if (received_bytes == 0) {
+    if (deadline != std::chrono::steady_clock::time_point::max() && this->reply.wait_until(deadline) != std::future_status::ready)
+    {
+        this->connection->cancelRequest(this->request, timeout);
+        throw TermConnectionError("Timeout while waiting for the reply.");
+    }
+    return this->reply.get();
+}
 
-            return {-1,std::vector<uint8_t>()};
-        } else if (received_bytes == -1) {
+std::string ZenniumConnection::ReplyToken::getString(const std::chrono::duration<int, std::milli> timeout)
+{
+    auto telegram = this->get(timeout);
+    std::string replyString(reinterpret_cast<char *>(telegram.data()), telegram.size());
 
-            connectionInterrupted = true;
-        }
+    this->connection->telegramPool.release(std::move(telegram));
+    return replyString;
+}
 
-#ifdef _WIN32
-        total_received_bytes += received_bytes;
-#else
-        total_received_bytes += static_cast<size_t>(received_bytes);
-#endif
+bool ZenniumConnection::ReplyToken::isReady() const
+{
+    return this->reply.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+void ZenniumConnection::ReplyToken::cancel()
+{
+    // Nothing to cancel after the token was moved or the reply was taken.
+    if (this->request != nullptr && this->reply.valid() == true)
+    {
+        this->connection->cancelRequest(this->request, this->connection->defaultTimeout);
+    }
+}
 
-    } while ((total_received_bytes < 3) && (connectionInterrupted == false));
+void ZenniumConnection::cancelRequest(const std::shared_ptr<PendingReply> &request, const std::chrono::duration<int, std::milli> expiryTime)
+{
+    std::unique_lock<std::mutex> lock(this->pendingRepliesMutex);
+    auto &pendingReplies = this->pendingRepliesForChannels[request->answerMessageType];
 
-    if(connectionInterrupted == false)
+    if (std::find(pendingReplies.begin(), pendingReplies.end(), request) == pendingReplies.end())
     {
-        incoming_packet.resize(*length_data);
+        return;
+    }
 
-        total_received_bytes = 0;
+    request->expiry = std::min(request->expiry, deadlineAfter(expiryTime));
 
-        do
-        {
-            received_bytes = recv(this->socket_handle, reinterpret_cast<char *>(incoming_packet.data() + total_received_bytes), *length_data - total_received_bytes, 0);
+    if (request->occupiesPipelineSlot == true)
+    {
+        request->occupiesPipelineSlot = false;
+        this->pendingRepliesCount--;
+        lock.unlock();
+        this->pipelineSlotAvailable.notify_one();
+    }
+}
 
-            if (received_bytes == 0)
-            {
-                return {-1,std::vector<uint8_t>()};
-            } else if (received_bytes == -1)
-            {
-                connectionInterrupted = true;
-            }
+std::shared_ptr<ZenniumConnection::PendingReply> ZenniumConnection::takePendingReply(int message_type, std::span<const uint8_t> telegram)
+{
+    auto &pendingReplies = this->pendingRepliesForChannels[message_type];
 
-#ifdef _WIN32
-            total_received_bytes += received_bytes;
-#else
-            total_received_bytes += static_cast<size_t>(received_bytes);
-#endif
-        } while ((total_received_bytes < *length_data) && (connectionInterrupted == false));
+    if (pendingReplies.empty() == true)
+    {
+        return nullptr;
+    }
 
+    // Cancelled requests whose reply did not arrive in time would otherwise take the replies of the following requests.
+    const auto now = std::chrono::steady_clock::now();
+    pendingReplies.erase(std::remove_if(pendingReplies.begin(), pendingReplies.end(), [now](const std::shared_ptr<PendingReply> &request) {
+        return request->expiry <= now;
+    }), pendingReplies.end());
+
+    auto match = std::find_if(pendingReplies.begin(), pendingReplies.end(), [&telegram](const std::shared_ptr<PendingReply> &request) {
+        const auto &key = request->correlationKey;
+        return key.empty() == false && telegram.size() >= key.size() && std::memcmp(telegram.data(), key.data(), key.size()) == 0;
+    });
+
+    if (match == pendingReplies.end())
+    {
+        match = std::find_if(pendingReplies.begin(), pendingReplies.end(), [](const std::shared_ptr<PendingReply> &request) {
+            return request->correlationKey.empty();
+        });
+    }
+
+    // The format of a keyed reply is not guaranteed, a lone keyed request is the only possible receiver.
+    if (match == pendingReplies.end() && pendingReplies.size() == 1)
+    {
+        match = pendingReplies.begin();
     }
-    if(connectionInterrupted == true)
+
+    if (match == pendingReplies.end())
     {
-        incoming_packet.clear();
+        return nullptr;
     }
-    return {static_cast<unsigned char>(header_bytes[2]),incoming_packet};
+
+    auto request = std::move(*match);
+    pendingReplies.erase(match);
+    return request;
 }
 
-void ZenniumConnection::telegramListenerJob()
+std::future<std::string> ZenniumConnection::sendStringAndWaitForReplyStringAsync(std::string payload, int message_type)
 {
-    do {
-        auto telegram = readTelegramFromSocket();
+    return this->sendStringAndWaitForReplyStringAsync(payload, message_type, message_type);
+}
 
-        if (std::get<1>(telegram).size() > 0 && std::find(availableChannels.begin(), availableChannels.end(), std::get<0>(telegram)) != availableChannels.end())
+std::future<std::string> ZenniumConnection::sendStringAndWaitForReplyStringAsync(std::string payload, int message_type, int answer_message_type)
+{
+    auto promise = std::make_shared<std::promise<std::string>>();
+    auto future = promise->get_future();
+
+    this->sendStringAndWaitForReplyStringAsync(payload, message_type, answer_message_type, [promise](const std::string &reply, std::exception_ptr error) {
+        if (error)
         {
-            this->queuesForChannels[std::get<0>(telegram)]->put(std::get<1>(telegram));
+            promise->set_exception(error);
         }
-        else if(std::get<0>(telegram) == -1)
+        else
         {
-            /*
-             * Error:
-             * To free the waiting receive threads, the Empty Telegram is put into the queue.
-             * The receive thread is then terminated.
-             */
-            for(int channel : availableChannels)
-            {
-                this->queuesForChannels[channel]->put(std::vector<uint8_t>());
-            }
-            this->receiving_worker_is_running = false;
+            promise->set_value(reply);
         }
+    });
 
-    } while (this->receiving_worker_is_running);
+    return future;
 }
 
-void ZenniumConnection::startTelegramListener()
+void ZenniumConnection::sendStringAndWaitForReplyStringAsync(std::string payload, int message_type, int answer_message_type, ReplyCallback callback, SendPriority priority)
 {
+    auto request = std::make_shared<PendingReply>();
 
-    this->receiving_worker_is_running = true;
-    this->receivingWorker = new std::thread(&ZenniumConnection::telegramListenerJob, this);
+    request->completion = [callback](const std::vector<uint8_t> &reply, std::exception_ptr error) {
+        callback(std::string(reinterpret_cast<const char *>(reply.data()), reply.size()), error);
+    };
+
+    this->submitRequest(payload, message_type, answer_message_type, request, priority);
+}
+
+void ZenniumConnection::waitForTelegramAsync(int message_type, TelegramCallback callback)
+{
+    Telegram telegram;
+
+    {
+        std::lock_guard<std::mutex> lock(this->pendingRepliesMutex);
+
+        auto queue = this->getQueueForChannel(message_type);
+        this->checkSharedReading(message_type, queue);
+        if (queue->empty() == false)
+        {
+            telegram = queue->pop();
+        }
+        else if (this->acceptingReplies == true)
+        {
+            auto receiver = std::make_shared<PendingReply>();
+            receiver->completion = std::move(callback);
+            receiver->occupiesPipelineSlot = false;
+            this->pendingRepliesForChannels[message_type].push_back(receiver);
+            return;
+        }
+    }
+
+    if (telegram.empty() == true)
+    {
+        callback({}, std::make_exception_ptr(TermConnectionError("The connection to Term is closed.")));
+    }
+    else
+    {
+        auto payload = telegram.toVector(&this->telegramPool);
+        callback(payload, nullptr);
+        this->telegramPool.release(std::move(payload));
+    }
+}
+
+ThalesAwaitable<std::vector<uint8_t>> ZenniumConnection::waitForTelegramAwaitable(int message_type)
+{
+    return ThalesAwaitable<std::vector<uint8_t>>([this, message_type](auto completion) {
+        try
+        {
+            this->waitForTelegramAsync(message_type, [completion](const std::vector<uint8_t> &telegram, std::exception_ptr error) {
+                completion(telegram, error);
+            });
+        }
+        catch (...)
+        {
+            completion({}, std::current_exception());
+        }
+    });
+}
+
+ThalesAwaitable<std::string> ZenniumConnection::sendStringAndWaitForReplyStringAwaitable(std::string payload, int message_type, int answer_message_type)
+{
+    return ThalesAwaitable<std::string>([this, payload, message_type, answer_message_type](auto completion) {
+        try
+        {
+            this->sendStringAndWaitForReplyStringAsync(payload, message_type, answer_message_type, [completion](const std::string &reply, std::exception_ptr error) {
+                completion(reply, error);
+            });
+        }
+        catch (...)
+        {
+            completion({}, std::current_exception());
+        }
+    });
+}
+
+void ZenniumConnection::releaseTelegram(std::vector<uint8_t> &&telegram)
+{
+    this->telegramPool.release(std::move(telegram));
+}
+
+void ZenniumConnection::releaseTelegram(Telegram &&telegram)
+{
+    this->telegramPool.release(telegram.releaseBuffer());
+}
+
+void ZenniumConnection::setCallbackExecutor(ThreadPoolExecutor* executor)
+{
+    this->callbackExecutor = executor;
+}
+
+void ZenniumConnection::registerChannel(int message_type)
+{
+    if (message_type < 0 || message_type >= numberOfChannels)
+    {
+        throw TermConnectionError("Invalid message type " + std::to_string(message_type) + ".");
+    }
+
+    std::lock_guard<std::mutex> lock(this->channelRegistrationMutex);
+
+    if (this->channelTable[message_type] != nullptr)
+    {
+        return;
+    }
+
+    auto &queue = this->channelQueues[message_type];
+    if (queue == nullptr)
+    {
+        queue = std::make_unique<ThreadsafeQueue>();
+    }
+    else
+    {
+        while (queue->empty() == false)
+        {
+            queue->pop();
+        }
+    }
+
+    this->channelTable[message_type] = queue.get();
+}
+
+void ZenniumConnection::unregisterChannel(int message_type)
+{
+    if (message_type < 0 || message_type >= numberOfChannels)
+    {
+        throw TermConnectionError("Invalid message type " + std::to_string(message_type) + ".");
+    }
+
+    std::deque<std::shared_ptr<PendingReply>> pendingReplies;
+    TelegramQueue* queue;
+
+    {
+        std::lock_guard<std::mutex> registrationLock(this->channelRegistrationMutex);
+        std::lock_guard<std::mutex> lock(this->pendingRepliesMutex);
+
+        queue = this->channelTable[message_type].exchange(nullptr);
+        if (queue == nullptr)
+        {
+            return;
+        }
+
+        pendingReplies.swap(this->pendingRepliesForChannels[message_type]);
+        for (auto &request : pendingReplies)
+        {
+            if (request->occupiesPipelineSlot == true)
+            {
+                this->pendingRepliesCount--;
+            }
+        }
+    }
+    this->pipelineSlotAvailable.notify_all();
+
+    for (auto &request : pendingReplies)
+    {
+        request->complete({}, std::make_exception_ptr(TermConnectionError("The channel " + std::to_string(message_type) + " was unregistered.")), this->callbackExecutor);
+    }
+
+    queue->put(Telegram());
+    this->notifyAnyTelegramWaiters();
+}
+
+void ZenniumConnection::setChannelQueueCapacity(int message_type, size_t capacity, TelegramQueue::OverflowPolicy overflowPolicy)
+{
+    this->checkOverflowPolicy(capacity, overflowPolicy);
+    this->getQueueForChannel(message_type)->setCapacity(capacity, overflowPolicy);
+}
+
+void ZenniumConnection::setChannelQueueLockFree(int message_type, size_t capacity, LockFreeRingQueue::WaitStrategy waitStrategy, TelegramQueue::OverflowPolicy overflowPolicy)
+{
+    this->checkOverflowPolicy(capacity, overflowPolicy);
+
+    auto newQueue = std::make_unique<LockFreeRingQueue>(capacity, waitStrategy, overflowPolicy);
+    TelegramQueue* oldQueue;
+
+    {
+        std::lock_guard<std::mutex> registrationLock(this->channelRegistrationMutex);
+        std::lock_guard<std::mutex> lock(this->pendingRepliesMutex);
+
+        oldQueue = this->getQueueForChannel(message_type);
+
+        // Each channel is switched once, so at most one retired queue is kept per channel.
+        if (oldQueue->isSingleReader() == true)
+        {
+            throw TermConnectionError("The channel " + std::to_string(message_type) + " already has a lock-free queue.");
+        }
+        this->retiredQueues[message_type] = std::move(this->channelQueues[message_type]);
+        this->channelQueues[message_type] = std::move(newQueue);
+        this->channelTable[message_type] = this->channelQueues[message_type].get();
+    }
+
+    /*
+     * The receive thread may wait for space in the old queue. After the interruption it
+     * dispatches the telegram again and finds the new queue.
+     */
+    oldQueue->setInterrupted(true);
+    oldQueue->put(Telegram());
+    this->notifyAnyTelegramWaiters();
+}
+
+void ZenniumConnection::checkOverflowPolicy(size_t capacity, TelegramQueue::OverflowPolicy overflowPolicy) const
+{
+    // A thread of the reactor serves many connections, it must not wait until the application reads a queue.
+    if (this->reactor != nullptr && capacity > 0 && overflowPolicy == TelegramQueue::OverflowPolicy::BLOCK)
+    {
+        throw TermConnectionError("The overflow policy BLOCK cannot be used with a TelegramReactor.");
+    }
+}
+
+void ZenniumConnection::checkSharedReading(int message_type, const TelegramQueue* queue) const
+{
+    // The ring buffer supports only one reader, but these methods may read while another thread waits on the channel.
+    if (queue->isSingleReader() == true)
+    {
+        throw TermConnectionError("The channel " + std::to_string(message_type) + " has a lock-free queue, which cannot be read by waitForAny or waitForTelegramAsync.");
+    }
+}
+
+unsigned long ZenniumConnection::getDroppedTelegramCount(int message_type) const
+{
+    return this->getQueueForChannel(message_type)->getDroppedCount();
+}
+
+void ZenniumConnection::setQueuesInterrupted(bool interrupted)
+{
+    std::lock_guard<std::mutex> lock(this->channelRegistrationMutex);
+
+    for (auto &queue : this->channelQueues)
+    {
+        if (queue != nullptr)
+        {
+            queue->setInterrupted(interrupted);
+        }
+    }
+}
+
+bool ZenniumConnection::isChannelRegistered(int message_type) const
+{
+    return message_type >= 0 && message_type < numberOfChannels && this->channelTable[message_type] != nullptr;
+}
+
+int ZenniumConnection::subscribe(int message_type, TelegramCallback handler, ThreadPoolExecutor* executor)
+{
+    auto subscription = std::make_shared<Subscription>();
+    subscription->handler = std::move(handler);
+    subscription->executor = executor;
+    subscription->active = true;
+
+    std::lock_guard<std::mutex> lock(this->pendingRepliesMutex);
+
+    if (this->isChannelRegistered(message_type) == false)
+    {
+        throw TermConnectionError("The channel " + std::to_string(message_type) + " is not registered.");
+    }
+
+    subscription->id = this->nextSubscriptionId++;
+
+    auto subscriptions = std::make_shared<SubscriptionList>();
+    if (this->subscriptionsForChannels[message_type] != nullptr)
+    {
+        *subscriptions = *this->subscriptionsForChannels[message_type];
+    }
+    subscriptions->push_back(subscription);
+    this->subscriptionsForChannels[message_type] = subscriptions;
+
+    return subscription->id;
+}
+
+void ZenniumConnection::unsubscribe(int subscriptionId)
+{
+    std::lock_guard<std::mutex> lock(this->pendingRepliesMutex);
+
+    for (auto &channel : this->subscriptionsForChannels)
+    {
+        if (channel == nullptr)
+        {
+            continue;
+        }
+
+        auto subscription = std::find_if(channel->begin(), channel->end(), [subscriptionId](const auto &entry) {
+            return entry->id == subscriptionId;
+        });
+
+        if (subscription != channel->end())
+        {
+            (*subscription)->active = false;
+
+            auto subscriptions = std::make_shared<SubscriptionList>(*channel);
+            subscriptions->erase(subscriptions->begin() + (subscription - channel->begin()));
+            channel = subscriptions->empty() ? nullptr : subscriptions;
+            return;
+        }
+    }
+}
+
+void ZenniumConnection::Subscription::deliver(const std::vector<uint8_t> &telegram, std::exception_ptr error)
+{
+    if (this->executor != nullptr)
+    {
+        this->executor->post([subscription = this->shared_from_this(), telegram, error]() {
+            if (subscription->active == true)
+            {
+                subscription->handler(telegram, error);
+            }
+        });
+    }
+    else if (ZenniumConnection::deferredCallbacks != nullptr)
+    {
+        ZenniumConnection::deferredCallbacks->push_back([subscription = this->shared_from_this(), telegram, error]() {
+            subscription->deliver(telegram, error);
+        });
+    }
+    else if (this->active == true)
+    {
+        try
+        {
+            this->handler(telegram, error);
+        }
+        catch (...)
+        {
+            // Exceptions of handlers must not terminate the receive thread.
+        }
+    }
+}
+
+TelegramQueue* ZenniumConnection::getQueueForChannel(int message_type) const
+{
+    if (this->isChannelRegistered(message_type) == false)
+    {
+        throw TermConnectionError("The channel " + std::to_string(message_type) + " is not registered.");
+    }
+    return this->channelTable[message_type];
+}
+
+void ZenniumConnection::PendingReply::complete(std::vector<uint8_t> &&reply, std::exception_ptr error, ThreadPoolExecutor* executor)
+{
+    if (this->completion && executor != nullptr)
+    {
+        executor->post([completion = this->completion, reply = std::move(reply), error]() {
+            completion(reply, error);
+        });
+    }
+    else if (this->completion && ZenniumConnection::deferredCallbacks != nullptr)
+    {
+        ZenniumConnection::deferredCallbacks->push_back([completion = this->completion, reply = std::move(reply), error]() {
+            try
+            {
+                completion(reply, error);
+            }
+            catch (...)
+            {
+                // Exceptions of callbacks must not terminate the thread of the reactor.
+            }
+        });
+    }
+    else if (this->completion)
+    {
+        try
+        {
+            this->completion(reply, error);
+        }
+        catch (...)
+        {
+            // Exceptions of callbacks must not terminate the receive thread.
+        }
+    }
+    else if (error)
+    {
+        this->promise.set_exception(error);
+    }
+    else
+    {
+        this->promise.set_value(std::move(reply));
+    }
+}
+
+std::shared_ptr<ZenniumConnection::PendingReply> ZenniumConnection::submitRequest(std::string_view payload, int message_type, int answer_message_type, std::shared_ptr<PendingReply> request, SendPriority priority)
+{
+    if (request == nullptr)
+    {
+        request = std::make_shared<PendingReply>();
+    }
+    request->answerMessageType = answer_message_type;
+
+    {
+        std::unique_lock<std::mutex> lock(this->pendingRepliesMutex);
+        auto slotAvailable = [this, priority]() {
+            return priority == SendPriority::URGENT || this->pendingRepliesCount < this->pipelineDepth || this->acceptingReplies == false;
+        };
+
+        if (this->inlineReceive == true)
+        {
+            // No other thread receives the replies which free the pipeline slots.
+            while (slotAvailable() == false)
+            {
+                lock.unlock();
+                this->waitInline([this, &slotAvailable]() {
+                    std::lock_guard<std::mutex> lock(this->pendingRepliesMutex);
+                    return slotAvailable();
+                }, std::chrono::duration<int, std::milli>::max());
+                lock.lock();
+            }
+        }
+        this->pipelineSlotAvailable.wait(lock, slotAvailable);
+
+        if (this->acceptingReplies == false)
+        {
+            throw TermConnectionError("The connection to Term is closed.");
+        }
+        this->pendingRepliesCount++;
+    }
+
+    const auto bytes = std::as_bytes(std::span<const char>(payload.data(), payload.size()));
+
+    while (true)
+    {
+        try
+        {
+            if (this->queueTelegram(bytes, message_type, priority, request, answer_message_type) == true)
+            {
+                return request;
+            }
+        }
+        catch (...)
+        {
+            // The request is registered only if the telegram was queued.
+            {
+                std::lock_guard<std::mutex> lock(this->pendingRepliesMutex);
+                this->pendingRepliesCount--;
+            }
+            this->pipelineSlotAvailable.notify_one();
+            throw;
+        }
+
+        /*
+         * Without send queue the request is registered while the send mutex is held,
+         * so the order of the registered requests is the order on the network.
+         */
+        std::lock_guard<std::mutex> sendLock(this->sendMutex);
+
+        if (this->sendQueueEnabled == true)
+        {
+            // The send queue was enabled in the meantime.
+            continue;
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(this->pendingRepliesMutex);
+
+            if (this->isChannelRegistered(answer_message_type) == false)
+            {
+                this->pendingRepliesCount--;
+                lock.unlock();
+                this->pipelineSlotAvailable.notify_one();
+                throw TermConnectionError("The channel " + std::to_string(answer_message_type) + " is not registered.");
+            }
+            this->pendingRepliesForChannels[answer_message_type].push_back(request);
+        }
+
+        try
+        {
+            this->writeTelegram(bytes, message_type);
+        }
+        catch (...)
+        {
+            std::unique_lock<std::mutex> lock(this->pendingRepliesMutex);
+            auto &pendingReplies = this->pendingRepliesForChannels[answer_message_type];
+            auto registered = std::find(pendingReplies.begin(), pendingReplies.end(), request);
+            if (registered != pendingReplies.end())
+            {
+                pendingReplies.erase(registered);
+                this->pendingRepliesCount--;
+            }
+            lock.unlock();
+            this->pipelineSlotAvailable.notify_one();
+            throw;
+        }
+
+        return request;
+    }
+}
+
+void ZenniumConnection::setPipelineDepth(int depth)
+{
+    {
+        std::lock_guard<std::mutex> lock(this->pendingRepliesMutex);
+        this->pipelineDepth = std::max(depth, 1);
+    }
+    this->pipelineSlotAvailable.notify_all();
+}
+
+void ZenniumConnection::enableSendQueue(bool enable)
+{
+    if(enable == false)
+    {
+        this->disableSendQueue();
+        return;
+    }
+
+    std::lock_guard<std::mutex> sendLock(this->sendMutex);
+    if(this->sendQueueEnabled == true)
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(this->sendQueueMutex);
+        this->sendQueueRunning = true;
+        this->sendQueueData.reserve(sendQueueReserve);
+    }
+    this->sendWorker = new std::thread(&ZenniumConnection::sendQueueJob, this);
+    this->sendQueueEnabled = true;
+}
+
+bool ZenniumConnection::queueTelegram(std::span<const std::byte> payload, int message_type, SendPriority priority, const std::shared_ptr<PendingReply> &request, int answer_message_type)
+{
+    if(payload.size() > 0xFFFF)
+    {
+        throw TermConnectionError("The payload of a telegram can be at most 65535 bytes long.");
+    }
+
+    const char header[3] =
+    {
+        static_cast<char>(payload.size() & 0xFF),
+        static_cast<char>((payload.size() >> 8) & 0xFF),
+        static_cast<char>(message_type)
+    };
+
+    std::unique_lock<std::mutex> lock(this->sendQueueMutex);
+
+    // Urgent telegrams are not limited, so they do not wait for the normal telegrams.
+    this->sendQueueSpaceAvailable.wait(lock, [this, priority]() {
+        return priority == SendPriority::URGENT || this->sendQueueData.size() < maximumSendQueueSize || this->sendQueueFailed == true || this->sendQueueRunning == false;
+    });
+
+    if(this->sendQueueRunning == false)
+    {
+        return false;
+    }
+
+    if(this->sendQueueFailed == true)
+    {
+        throw TermConnectionError("Socket error during data transmission.");
+    }
+
+    if(request != nullptr)
+    {
+        /*
+         * The request is registered while the send queue is locked, so the writer thread cannot take the
+         * queued telegrams between the registration and the queuing of the telegram.
+         */
+        std::lock_guard<std::mutex> pendingLock(this->pendingRepliesMutex);
+
+        if (this->isChannelRegistered(answer_message_type) == false)
+        {
+            throw TermConnectionError("The channel " + std::to_string(answer_message_type) + " is not registered.");
+        }
+
+        auto &pendingReplies = this->pendingRepliesForChannels[answer_message_type];
+        auto &queuedRequests = this->queuedRequestsForChannels[answer_message_type];
+
+        if(priority == SendPriority::URGENT)
+        {
+            queuedRequests = std::min<int>(queuedRequests, static_cast<int>(pendingReplies.size()));
+            pendingReplies.insert(pendingReplies.end() - queuedRequests, request);
+        }
+        else
+        {
+            pendingReplies.push_back(request);
+            queuedRequests++;
+        }
+    }
+
+    auto &queue = (priority == SendPriority::URGENT) ? this->urgentSendQueueData : this->sendQueueData;
+    const char *data = reinterpret_cast<const char *>(payload.data());
+    queue.insert(queue.end(), header, header + sizeof(header));
+    queue.insert(queue.end(), data, data + payload.size());
+
+    lock.unlock();
+    this->sendQueueDataAvailable.notify_one();
+    return true;
+}
+
+void ZenniumConnection::enableInlineReceive(bool enable)
+{
+    if (this->isConnectedToTerm() == true)
+    {
+        throw TermConnectionError("The receive mode can only be changed before connecting.");
+    }
+    this->inlineReceive = enable;
+}
+
+bool ZenniumConnection::receiveInline(const std::chrono::duration<int, std::milli> timeout)
+{
+    std::unique_lock<std::mutex> lock(this->inlineReceiveMutex, std::try_to_lock);
+
+    if (lock.owns_lock() == false)
+    {
+        // Another thread has read the socket in the meantime, possibly the telegram of this thread.
+        lock.lock();
+        return this->receiving_worker_is_running;
+    }
+
+    if (this->receiving_worker_is_running == false)
+    {
+        return false;
+    }
+
+    if (timeout != std::chrono::duration<int, std::milli>::max())
+    {
+        fd_set readSockets;
+        FD_ZERO(&readSockets);
+        FD_SET(this->socket_handle, &readSockets);
+
+        struct timeval selectTimeout;
+        selectTimeout.tv_sec = static_cast<long>(timeout.count() / 1000);
+        selectTimeout.tv_usec = static_cast<long>((timeout.count() % 1000) * 1000);
+
+        if (select(static_cast<int>(this->socket_handle) + 1, &readSockets, nullptr, nullptr, &selectTimeout) <= 0)
+        {
+            return true;
+        }
+    }
+
+    auto received_bytes = this->receiveIntoBuffer(0);
+
+    if (received_bytes <= 0)
+    {
+#ifndef _WIN32
+        if (received_bytes < 0 && errno == EINTR)
+        {
+            return true;
+        }
+#endif
+        this->receiving_worker_is_running = false;
+        this->releaseWaitingReceivers();
+        return false;
+    }
+
+    Telegram telegram;
+    while (this->extractTelegramFromBuffer(telegram))
+    {
+        this->dispatchTelegram(std::move(telegram));
+    }
+    return true;
+}
+
+template <typename Condition>
+bool ZenniumConnection::waitInline(Condition condition, const std::chrono::duration<int, std::milli> timeout)
+{
+    const auto deadline = deadlineAfter(timeout);
+
+    while (condition() == false)
+    {
+        if (deadline != std::chrono::steady_clock::time_point::max() && std::chrono::steady_clock::now() >= deadline)
+        {
+            return false;
+        }
+
+        if (this->receiveInline(timeUntil(deadline)) == false)
+        {
+            // The waiting receivers were released when the connection was closed.
+            return condition();
+        }
+    }
+    return true;
+}
+
+void ZenniumConnection::disableSendQueue()
+{
+    std::lock_guard<std::mutex> sendLock(this->sendMutex);
+    if(this->sendQueueEnabled == false)
+    {
+        return;
+    }
+    this->sendQueueEnabled = false;
+
+    {
+        std::lock_guard<std::mutex> lock(this->sendQueueMutex);
+        this->sendQueueRunning = false;
+    }
+    this->sendQueueDataAvailable.notify_one();
+
+    // Threads waiting for space send their telegrams directly after the queued ones have been sent.
+    this->sendQueueSpaceAvailable.notify_all();
+
+    this->sendWorker->join();
+    delete this->sendWorker;
+    this->sendWorker = nullptr;
+}
+
+void ZenniumConnection::sendQueueJob()
+{
+    // The buffers are swapped, so their capacity is kept and no memory is allocated while sending.
+    std::vector<char> urgentData;
+    std::vector<char> data;
+    urgentData.reserve(sendQueueReserve);
+    data.reserve(sendQueueReserve);
+
+    std::unique_lock<std::mutex> lock(this->sendQueueMutex);
+
+    while(true)
+    {
+        this->sendQueueDataAvailable.wait(lock, [this]() {
+            return this->sendQueueData.empty() == false || this->urgentSendQueueData.empty() == false || this->sendQueueRunning == false;
+        });
+
+        if(this->sendQueueData.empty() == true && this->urgentSendQueueData.empty() == true)
+        {
+            break;
+        }
+
+        urgentData.swap(this->urgentSendQueueData);
+        data.swap(this->sendQueueData);
+        this->queuedRequestsForChannels.fill(0);
+        this->sendQueueBusy = true;
+        const bool failed = this->sendQueueFailed;
+        lock.unlock();
+        this->sendQueueSpaceAvailable.notify_all();
+
+        // All telegrams queued since the last write are sent with one system call, the urgent ones first.
+        SendBuffer buffers[2] =
+        {
+            {urgentData.data(), urgentData.size()},
+            {data.data(), data.size()}
+        };
+        bool success = failed == false && this->sendBuffers(buffers, 2);
+        urgentData.clear();
+        data.clear();
+
+        lock.lock();
+        this->sendQueueBusy = false;
+        if(success == false)
+        {
+            this->sendQueueFailed = true;
+        }
+        this->sendQueueSpaceAvailable.notify_all();
+    }
+}
+
+void ZenniumConnection::flushSendQueue()
+{
+    std::unique_lock<std::mutex> lock(this->sendQueueMutex);
+    this->sendQueueSpaceAvailable.wait(lock, [this]() {
+        return this->sendQueueData.empty() == true && this->urgentSendQueueData.empty() == true && this->sendQueueBusy == false;
+    });
+}
+
+int ZenniumConnection::getPipelineDepth()
+{
+    std::lock_guard<std::mutex> lock(this->pendingRepliesMutex);
+    return this->pipelineDepth;
+}
+
+std::string ZenniumConnection::getConnectionName()
+{
+    return this->connectionName;
+}
+
+void ZenniumConnection::setTimeout(const std::chrono::duration<int, std::milli> timeout)
+{
+    this->defaultTimeout = timeout;
+}
+
+std::chrono::duration<int, std::milli> ZenniumConnection::getTimeout()
+{
+    return this->defaultTimeout;
+}
+
+Telegram ZenniumConnection::readTelegramFromSocket()
+{
+    Telegram telegram;
+
+    while (this->extractTelegramFromBuffer(telegram) == false)
+    {
+        auto received_bytes = this->receiveIntoBuffer(0);
+
+        if (received_bytes == 0)
+        {
+            return Telegram();
+        }
+        else if (received_bytes < 0)
+        {
+#ifndef _WIN32
+            if (errno == EINTR)
+            {
+                continue;
+            }
+#endif
+            return Telegram();
+        }
+    }
+
+    return telegram;
+}
+
+bool ZenniumConnection::receiveAvailableTelegrams()
+{
+    Telegram telegram;
+
+    while (true)
+    {
+#ifdef _WIN32
+        auto received_bytes = this->receiveIntoBuffer(0);
+#else
+        auto received_bytes = this->receiveIntoBuffer(MSG_DONTWAIT);
+#endif
+
+        if (received_bytes == 0)
+        {
+            return false;
+        }
+        else if (received_bytes < 0)
+        {
+#ifndef _WIN32
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+            {
+                return true;
+            }
+            else if (errno == EINTR)
+            {
+                continue;
+            }
+#endif
+            return false;
+        }
+
+        while (this->extractTelegramFromBuffer(telegram))
+        {
+            this->dispatchTelegram(std::move(telegram));
+        }
+    }
+}
+
+long ZenniumConnection::receiveIntoBuffer(int flags)
+{
+    if (this->receiveBufferStart > 0)
+    {
+        std::memmove(this->receiveBuffer.data(), this->receiveBuffer.data() + this->receiveBufferStart, this->receiveBufferFill - this->receiveBufferStart);
+        this->receiveBufferFill -= this->receiveBufferStart;
+        this->receiveBufferStart = 0;
+    }
+
+#ifdef _WIN32
+    long received_bytes = recv(this->socket_handle, reinterpret_cast<char *>(this->receiveBuffer.data() + this->receiveBufferFill), static_cast<int>(this->receiveBuffer.size() - this->receiveBufferFill), flags);
+#else
+    long received_bytes = recv(this->socket_handle, this->receiveBuffer.data() + this->receiveBufferFill, this->receiveBuffer.size() - this->receiveBufferFill, flags);
+#endif
+
+    if (received_bytes > 0)
+    {
+        this->receiveBufferFill += static_cast<size_t>(received_bytes);
+    }
+
+    return received_bytes;
+}
+
+bool ZenniumConnection::extractTelegramFromBuffer(Telegram &telegram)
+{
+    while (this->receiveBufferFill - this->receiveBufferStart >= 3)
+    {
+        const size_t availableBytes = this->receiveBufferFill - this->receiveBufferStart;
+        const uint8_t *header = this->receiveBuffer.data() + this->receiveBufferStart;
+        const size_t payloadLength = static_cast<size_t>(header[0]) | (static_cast<size_t>(header[1]) << 8);
+
+        if (availableBytes < payloadLength + 3)
+        {
+            return false;
+        }
+
+        this->receiveBufferStart += payloadLength + 3;
+
+        if (this->channelTable[header[2]] != nullptr)
+        {
+            // Short telegrams are stored inline, only large ones take a buffer from the pool.
+            telegram = Telegram(header[2], header + 3, payloadLength, &this->telegramPool, std::chrono::steady_clock::now());
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ZenniumConnection::dispatchTelegram(Telegram &&telegram)
+{
+    if (telegram.empty() == true)
+    {
+        return;
+    }
+
+    while (this->dispatchTelegramOrWait(telegram) == false)
+    {
+        // The queue was full, the receiver may have changed while waiting for space.
+    }
+
+    // Returns the buffer if the receiver did not take it.
+    this->telegramPool.release(telegram.releaseBuffer());
+}
+
+bool ZenniumConnection::dispatchTelegramOrWait(Telegram &telegram)
+{
+    const int message_type = telegram.getMessageType();
+
+    std::unique_lock<std::mutex> lock(this->pendingRepliesMutex);
+    auto request = this->takePendingReply(message_type, telegram.span());
+
+    if (request != nullptr)
+    {
+        if (request->occupiesPipelineSlot == true)
+        {
+            this->pendingRepliesCount--;
+        }
+        lock.unlock();
+        this->pipelineSlotAvailable.notify_one();
+
+        request->complete(telegram.toVector(&this->telegramPool), nullptr, this->callbackExecutor);
+        return true;
+    }
+
+    auto subscriptions = this->subscriptionsForChannels[message_type];
+    if (subscriptions != nullptr)
+    {
+        lock.unlock();
+
+        auto payload = telegram.toVector(&this->telegramPool);
+        for (auto &subscription : *subscriptions)
+        {
+            subscription->deliver(payload, nullptr);
+        }
+        this->telegramPool.release(std::move(payload));
+        return true;
+    }
+
+    /*
+     * The telegram is put into the queue while the lock is held,
+     * so waitForTelegramAsync either finds it in the queue or is registered before.
+     */
+    TelegramQueue* queue = this->channelTable[message_type];
+    if (queue == nullptr)
+    {
+        return true;
+    }
+    if (queue->tryPut(std::move(telegram)) == true)
+    {
+        this->notifyAnyTelegramWaiters();
+        return true;
+    }
+
+    /*
+     * The queue is full and blocks. The lock must not be held while waiting, because
+     * the readers need it. Since there is only one writer, the space remains available.
+     */
+    lock.unlock();
+    queue->waitForSpace();
+    return false;
+}
+
+void ZenniumConnection::releaseWaitingReceivers()
+{
+    std::vector<std::shared_ptr<PendingReply>> pendingReplies;
+    std::vector<std::shared_ptr<const SubscriptionList>> subscriptions;
+
+    {
+        std::lock_guard<std::mutex> lock(this->pendingRepliesMutex);
+        for (auto &channel : this->subscriptionsForChannels)
+        {
+            if (channel != nullptr)
+            {
+                subscriptions.push_back(channel);
+            }
+        }
+        for (auto &channel : this->pendingRepliesForChannels)
+        {
+            std::move(channel.begin(), channel.end(), std::back_inserter(pendingReplies));
+            channel.clear();
+        }
+        this->pendingRepliesCount = 0;
+        this->acceptingReplies = false;
+    }
+    this->pipelineSlotAvailable.notify_all();
+
+    for (auto &request : pendingReplies)
+    {
+        request->complete({}, std::make_exception_ptr(TermConnectionError("The connection to Term was closed.")), this->callbackExecutor);
+    }
+
+    for (auto &channel : subscriptions)
+    {
+        for (auto &subscription : *channel)
+        {
+            subscription->deliver({}, std::make_exception_ptr(TermConnectionError("The connection to Term was closed.")));
+        }
+    }
+
+    for(auto &channel : this->channelTable)
+    {
+        TelegramQueue* queue = channel;
+        if (queue != nullptr)
+        {
+            queue->put(Telegram());
+        }
+    }
+    this->notifyAnyTelegramWaiters();
+}
+
+void ZenniumConnection::telegramListenerJob()
+{
+    do {
+        auto telegram = readTelegramFromSocket();
+
+        if(telegram.getMessageType() == -1)
+        {
+            /*
+             * Error:
+             * To free the waiting receive threads, the Empty Telegram is put into the queue.
+             * The receive thread is then terminated.
+             */
+            this->releaseWaitingReceivers();
+            this->receiving_worker_is_running = false;
+        }
+        else
+        {
+            this->dispatchTelegram(std::move(telegram));
+        }
+
+    } while (this->receiving_worker_is_running);
+}
+
+void ZenniumConnection::startTelegramListener()
+{
+    this->receiveBuffer.resize(receiveBufferSize);
+    this->receiveBufferStart = 0;
+    this->receiveBufferFill = 0;
+
+    {
+        std::lock_guard<std::mutex> lock(this->pendingRepliesMutex);
+        this->acceptingReplies = true;
+    }
+    this->setQueuesInterrupted(false);
+
+    if(this->inlineReceive == true)
+    {
+        // The reading thread cannot wait for space, which only it could make.
+        this->setQueuesInterrupted(true);
+        this->receiving_worker_is_running = true;
+    }
+    else if(this->reactor != nullptr)
+    {
+        this->reactor->registerConnection(this);
+    }
+    else
+    {
+        this->receiving_worker_is_running = true;
+        this->receivingWorker = new std::thread(&ZenniumConnection::telegramListenerJob, this);
+    }
 }
 
 void ZenniumConnection::stopTelegramListener()
 {
     shutdown(this->socket_handle, SHUT_RD);
 
-    this->receiving_worker_is_running = false;
-    this->receivingWorker->join();
+    // The receiving thread may wait for space in a full queue.
+    this->setQueuesInterrupted(true);
+
+    if(this->inlineReceive == true)
+    {
+        // A thread reading the socket returns because of the shutdown.
+        std::lock_guard<std::mutex> lock(this->inlineReceiveMutex);
+        if(this->receiving_worker_is_running == true)
+        {
+            this->receiving_worker_is_running = false;
+            this->releaseWaitingReceivers();
+        }
+    }
+    else if(this->reactor != nullptr)
+    {
+        if(this->reactor->unregisterConnection(this) == true)
+        {
+            this->releaseWaitingReceivers();
+        }
+    }
+    else
+    {
+        this->receiving_worker_is_running = false;
+        this->receivingWorker->join();
+    }
 }
 
 std::chrono::milliseconds ZenniumConnection::getCurrentTimeInMilliseconds() const
@@ -404,8 +1762,36 @@ std::chrono::milliseconds ZenniumConnection::getCurrentTimeInMilliseconds() cons
     return std::chrono::duration_cast<std::chrono::milliseconds >(std::chrono::system_clock::now().time_since_epoch());
 }
 
+std::chrono::steady_clock::time_point ZenniumConnection::deadlineAfter(const std::chrono::duration<int, std::milli> timeout)
+{
+    if (timeout == std::chrono::duration<int, std::milli>::max())
+    {
+        return std::chrono::steady_clock::time_point::max();
+    }
+    return std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+}
+
+std::chrono::duration<int, std::milli> ZenniumConnection::timeUntil(const std::chrono::steady_clock::time_point deadline)
+{
+    if (deadline == std::chrono::steady_clock::time_point::max())
+    {
+        return std::chrono::duration<int, std::milli>::max();
+    }
+
+    // Rounded up, so a wait does not end shortly before the deadline.
+    auto remaining = std::chrono::ceil<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+    return std::chrono::duration<int, std::milli>(std::max<std::chrono::milliseconds::rep>(remaining.count(), 0));
+}
+
 void ZenniumConnection::closeSocket()
 {
+    this->flushSendQueue();
+
+    {
+        // The error of the writer thread belongs to the closed socket.
+        std::lock_guard<std::mutex> lock(this->sendQueueMutex);
+        this->sendQueueFailed = false;
+    }
 
 #ifdef _WIN32
     closesocket(this->socket_handle);
@@ -415,3 +1801,214 @@ void ZenniumConnection::closeSocket()
 
     this->socket_handle = INVALID_SOCKET;
 }
+
+void ZenniumConnection::openSocket(const std::string &address, const std::chrono::duration<int, std::milli> timeout)
+{
+    this->socket_handle = socket(AF_INET, SOCK_STREAM, 0);
+
+#ifdef _WIN32
+    if (this->socket_handle == INVALID_SOCKET) {
+#else
+    if (this->socket_handle < 0) {
+#endif
+
+        throw TermConnectionError("Could not create socket");
+    }
+
+    struct addrinfo hints = {};
+    struct addrinfo *result_pointer;
+
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_protocol = IPPROTO_TCP;
+
+    if (getaddrinfo(address.data(), "260", &hints, &result_pointer) != 0)
+    {
+        this->closeSocket();
+        throw TermConnectionError("Error while resolving address");
+    }
+
+    struct addrinfo *first_addr = result_pointer;
+
+    if (first_addr == nullptr)
+    {
+        freeaddrinfo(result_pointer);
+        this->closeSocket();
+        throw TermConnectionError("Could not resolve hostname");
+    }
+
+    if (timeout == std::chrono::duration<int, std::milli>::max())
+    {
+        int status = connect(this->socket_handle, first_addr->ai_addr, static_cast<int>(first_addr->ai_addrlen));
+        freeaddrinfo(result_pointer);
+
+        if (status < 0)
+        {
+            this->closeSocket();
+            throw TermConnectionError("Could not connect to term");
+        }
+        return;
+    }
+
+    /*
+     * Non-blocking connect, so that the connection attempt can be aborted after the timeout.
+     */
+#ifdef _WIN32
+    u_long nonBlocking = 1;
+    ioctlsocket(this->socket_handle, FIONBIO, &nonBlocking);
+#else
+    int socketFlags = fcntl(this->socket_handle, F_GETFL, 0);
+    fcntl(this->socket_handle, F_SETFL, socketFlags | O_NONBLOCK);
+#endif
+
+    int status = connect(this->socket_handle, first_addr->ai_addr, static_cast<int>(first_addr->ai_addrlen));
+    freeaddrinfo(result_pointer);
+
+#ifdef _WIN32
+    bool connectionPending = (status < 0) && (WSAGetLastError() == WSAEWOULDBLOCK);
+#else
+    bool connectionPending = (status < 0) && (errno == EINPROGRESS);
+#endif
+
+    if (status < 0 && connectionPending == false)
+    {
+        this->closeSocket();
+        throw TermConnectionError("Could not connect to term");
+    }
+
+    if (connectionPending == true)
+    {
+        fd_set writeSet;
+        FD_ZERO(&writeSet);
+        FD_SET(this->socket_handle, &writeSet);
+
+        struct timeval selectTimeout;
+        selectTimeout.tv_sec = static_cast<long>(timeout.count() / 1000);
+        selectTimeout.tv_usec = static_cast<long>((timeout.count() % 1000) * 1000);
+
+        int socketError = 0;
+        socklen_t socketErrorLength = sizeof(socketError);
+
+        if (select(static_cast<int>(this->socket_handle) + 1, nullptr, &writeSet, nullptr, &selectTimeout) <= 0)
+        {
+            this->closeSocket();
+            throw TermConnectionError("Could not connect to term within " + std::to_string(timeout.count()) + " ms.");
+        }
+
+        getsockopt(this->socket_handle, SOL_SOCKET, SO_ERROR, reinterpret_cast<char *>(&socketError), &socketErrorLength);
+
+        if (socketError != 0)
+        {
+            this->closeSocket();
+            throw TermConnectionError("Could not connect to term");
+        }
+    }
+
+#ifdef _WIN32
+    nonBlocking = 0;
+    ioctlsocket(this->socket_handle, FIONBIO, &nonBlocking);
+#else
+    fcntl(this->socket_handle, F_SETFL, socketFlags);
+#endif
+}
+
+void ZenniumConnection::sendRegistrationPacket()
+{
+    unsigned short payload_length = static_cast<unsigned short>(connectionName.length());
+
+    std::vector<unsigned char> registration_packet;
+
+    registration_packet.reserve(payload_length + 6);
+
+    registration_packet.push_back(reinterpret_cast<unsigned char *>(&payload_length)[1]);
+    registration_packet.push_back(reinterpret_cast<unsigned char *>(&payload_length)[0]);
+
+    const std::vector<unsigned char> fixedHeaderBytes =
+    {
+        0x12, 0xd0,
+        0xff, 0xff,
+        0xff, 0xff
+    };
+
+    registration_packet.insert(registration_packet.end(), fixedHeaderBytes.begin(), fixedHeaderBytes.end());
+
+    std::copy(connectionName.begin(), connectionName.end(), std::back_inserter(registration_packet));
+
+    int status = sendall(this->socket_handle, reinterpret_cast<char *>(registration_packet.data()), static_cast<int>(registration_packet.size()), 0);
+
+    if(status == -1)
+    {
+        throw TermConnectionError("Socket error during data transmission.");
+    }
+}
+
+bool ZenniumConnection::sendBuffers(SendBuffer *buffers, size_t numberOfBuffers)
+{
+    constexpr size_t maximumBuffersPerWrite = 64;
+
+    while (numberOfBuffers > 0)
+    {
+        if (buffers->size == 0)
+        {
+            buffers++;
+            numberOfBuffers--;
+            continue;
+        }
+
+        const size_t buffersInThisWrite = std::min(numberOfBuffers, maximumBuffersPerWrite);
+
+#ifdef _WIN32
+        WSABUF vectors[maximumBuffersPerWrite];
+        for (size_t i = 0; i < buffersInThisWrite; i++)
+        {
+            vectors[i].buf = const_cast<char *>(buffers[i].data);
+            vectors[i].len = static_cast<ULONG>(buffers[i].size);
+        }
+
+        DWORD sent = 0;
+        if (WSASend(this->socket_handle, vectors, static_cast<DWORD>(buffersInThisWrite), &sent, 0, nullptr, nullptr) != 0)
+        {
+            return false;
+        }
+        size_t sentBytes = sent;
+#else
+        struct iovec vectors[maximumBuffersPerWrite];
+        for (size_t i = 0; i < buffersInThisWrite; i++)
+        {
+            vectors[i].iov_base = const_cast<char *>(buffers[i].data);
+            vectors[i].iov_len = buffers[i].size;
+        }
+
+        struct msghdr message = {};
+        message.msg_iov = vectors;
+        message.msg_iovlen = buffersInThisWrite;
+
+        ssize_t sent = sendmsg(this->socket_handle, &message, 0);
+        if (sent < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return false;
+        }
+        size_t sentBytes = static_cast<size_t>(sent);
+#endif
+
+        while (sentBytes > 0)
+        {
+            size_t consumed = std::min(sentBytes, buffers->size);
+            buffers->data += consumed;
+            buffers->size -= consumed;
+            sentBytes -= consumed;
+
+            if (buffers->size == 0)
+            {
+                buffers++;
+                numberOfBuffers--;
+            }
+        }
+    }
+
+    return true;
+}
@@ -38,7 +38,21 @@
 #include <algorithm>
 #include <vector>
 #include <unordered_map>
+#include <string_view>
+#include <span>
+#include <cstddef>
+#include <future>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <array>
+#include <atomic>
 #include "threadsafequeue.h"
+#include "lockfreeringqueue.h"
+#include "threadpoolexecutor.h"
+#include "telegrambufferpool.h"
+#include "telegram.h"
+#include "thalesremotecoroutine.h"
 #include <memory>
 
 #ifdef _WIN32
@@ -59,17 +73,57 @@
 #define INVALID_SOCKET -1
 
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <arpa/inet.h>
 #include <netinet/in.h>
 #include <netdb.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/select.h>
 
 #endif
 
+class TelegramReactor;
+
 class ZenniumConnection
 {
+    friend class TelegramReactor;
+
 public:
 
+    /** Callback which receives the reply to a request.
+     *
+     *  If the request failed, error contains the exception and reply is empty.
+     */
+    using ReplyCallback = std::function<void(const std::string &reply, std::exception_ptr error)>;
+
+    /** Handle of a request whose reply is delivered only to this handle, see sendTelegramWithReplyToken. */
+    class ReplyToken;
+
+    /** Priority of a telegram to be sent. */
+    enum class SendPriority
+    {
+        NORMAL,     /**< The telegrams are sent in the order of the calls. */
+        URGENT      /**< The telegram is sent before the normal telegrams which are still waiting, e.g. to switch off the potentiostat. */
+    };
+
+    /** Callback which receives a telegram.
+     *
+     *  If the telegram could not be received, error contains the exception and telegram is empty.
+     */
+    using TelegramCallback = std::function<void(const std::vector<uint8_t> &telegram, std::exception_ptr error)>;
+
     ZenniumConnection();
+
+    /** Constructor for a connection which is served by a TelegramReactor.
+     *
+     *  No separate receive thread is started for this connection. The incoming telegrams are read
+     *  by the threads of the reactor and put into the queues of the channels.
+     *
+     * \param  reactor The reactor which serves the connection. Must exist longer than the connection.
+     */
+    explicit ZenniumConnection(TelegramReactor* reactor);
+
     ~ZenniumConnection();
 
     /** Connect to Term Software(The Thales Terminal)
@@ -80,6 +134,21 @@ public:
      */
     bool connectToTerm(std::string address, std::string connectionName);
 
+    /** Connect to Term Software(The Thales Terminal) without fixed waiting times.
+     *
+     *  Instead of waiting fixed times for Term, the registration is confirmed with a HeartBeat request.
+     *  The method returns as soon as Term has answered the request and the connection can be used.
+     *
+     *  If the connection is not established within the timeout, the socket is closed again and a
+     *  TermConnectionError exception is thrown.
+     *
+     * \param  address The hostname or ip-address of the host running Term.
+     * \param  connectionName The name of the connection ScriptRemote for Remote and Logging as Online Display.
+     * \param  timeout Deadline in milliseconds for the complete connection setup.
+     * \return true on success
+     */
+    bool connectToTerm(std::string address, std::string connectionName, const std::chrono::duration<int, std::milli> timeout);
+
     /** Close the connection to Term and cleanup.
      *
      * Stops the thread used for receiving telegrams assynchronously and shuts down
@@ -93,6 +162,15 @@ public:
      */
     bool isConnectedToTerm() const;
 
+    /** Get the number of connections established with this object.
+     *
+     *  The number is incremented by each connectToTerm, so users of the connection can detect a reconnect
+     *  and discard state which belongs to the previous connection.
+     *
+     * \return The number of connections established so far.
+     */
+    unsigned long getConnectionCount() const;
+
     /** Wraps the socket send function in a loop.
      *
      *  Wraps the socket send function in a loop that all data is sent. The function tries to repeat the send as many times as there are bytes to prevent an infinite loop.
@@ -111,14 +189,45 @@ public:
      * \param  payload The actual data which is being sent to Term.
      * \param  message_type Used internally by the DevCli dll. Depends on context. Most of the time 2.
      */
-    void sendTelegram(std::string payload, int message_type);
+    void sendTelegram(const std::string &payload, int message_type);
+
+    /** Send a telegram (data) to Term.
+     *
+     * \param  payload The actual data which is being sent to Term.
+     * \param  message_type Used internally by the DevCli dll. Depends on context. Most of the time 2.
+     */
+    void sendTelegram(const char *payload, int message_type);
 
     /** Send a telegram (data) to Term.
      *
      * \param  payload The actual data which is being sent to Term.
      * \param  message_type Used internally by the DevCli dll. Depends on context. Most of the time 2.
      */
-    void sendTelegram(std::vector<unsigned char> payload, int message_type);
+    void sendTelegram(std::string_view payload, int message_type);
+
+    /** Send a telegram (data) to Term.
+     *
+     * \param  payload The actual data which is being sent to Term.
+     * \param  message_type Used internally by the DevCli dll. Depends on context. Most of the time 2.
+     */
+    void sendTelegram(const std::vector<unsigned char> &payload, int message_type);
+
+    /** Send a telegram (data) to Term.
+     *
+     *  The header and the payload are sent with one vectored write directly from the passed memory,
+     *  without copying the payload or allocating memory.
+     *  All other overloads of this method use this method.
+     *
+     *  If the payload is longer than 65535 bytes, a TermConnectionError exception is thrown.
+     *
+     *  With the send queue an urgent telegram is sent before the normal telegrams in the queue,
+     *  without send queue it is sent directly like a normal telegram.
+     *
+     * \param  payload The actual data which is being sent to Term.
+     * \param  message_type Used internally by the DevCli dll. Depends on context. Most of the time 2.
+     * \param  priority The priority of the telegram.
+     */
+    void sendTelegram(std::span<const std::byte> payload, int message_type, SendPriority priority = SendPriority::NORMAL);
 
     std::string waitForStringTelegram(int message_type);
     /** Block maximal timeout milliseconds while waiting for an incoming telegram.
@@ -157,6 +266,59 @@ public:
     std::vector<uint8_t> waitForTelegram(int message_type, const std::chrono::duration<int, std::milli> timeout);
     std::vector<uint8_t> waitForBinaryTelegram(int message_type, const std::chrono::duration<int, std::milli> timeout);
 
+    /** Block maximal timeout milliseconds while waiting for an incoming telegram.
+     *
+     *  Like waitForTelegram, but the telegram is returned as it was received. Short telegrams, e.g. the
+     *  replies to Remote2 commands, are stored in the Telegram itself, so no memory is allocated.
+     *  The payload can be read with Telegram::view or Telegram::span.
+     *
+     * \param  message_type Used internally by the DevCli dll. Depends on context. Most of the time 2.
+     * \param  timeout Timeout in milliseconds for waiting for the response.
+     *          If the overloaded method without timeout is used, then the default timeout is used.
+     *
+     * \return The received telegram with its message type and receive time.
+     * \throws TermConnectionError if the connection was closed or the channel was unregistered.
+     */
+    Telegram waitForTelegramMessage(int message_type);
+    Telegram waitForTelegramMessage(int message_type, const std::chrono::duration<int, std::milli> timeout);
+
+    /** Block until telegrams are available and read all of them at once.
+     *
+     *  Instead of one call per telegram like waitForTelegram, the queue of the channel is emptied with a
+     *  single lock. This is intended for channels with many telegrams, e.g. file data or online data.
+     *  The telegrams can be returned with releaseTelegram after use.
+     *
+     * \param  message_type The message type of the channel. The channel must be registered.
+     * \param  telegrams The received telegrams are appended to this vector.
+     * \param  maxCount Maximum number of telegrams to read, 0 for unlimited.
+     * \param  timeout Timeout in milliseconds for waiting for the first telegram.
+     *          If the overloaded method without timeout is used, then the default timeout is used.
+     *
+     * \return The number of appended telegrams, 0 if the timeout was reached.
+     * \throws TermConnectionError if the connection was closed or the channel was unregistered.
+     */
+    size_t drain(int message_type, std::vector<std::vector<uint8_t>> &telegrams, size_t maxCount = 0);
+    size_t drain(int message_type, std::vector<std::vector<uint8_t>> &telegrams, size_t maxCount, const std::chrono::duration<int, std::milli> timeout);
+    size_t drain(int message_type, std::vector<Telegram> &telegrams, size_t maxCount = 0);
+    size_t drain(int message_type, std::vector<Telegram> &telegrams, size_t maxCount, const std::chrono::duration<int, std::milli> timeout);
+
+    /** Block until a telegram is available on one of several channels.
+     *
+     *  A single thread can serve several channels, e.g. the replies on 128 and 132 and the data on 2,
+     *  without polling. If telegrams are available on several channels, the channel listed first is
+     *  read first. If another thread takes the telegram first, the method waits again until the timeout.
+     *
+     * \param  message_types The message types of the channels. The channels must be registered.
+     * \param  timeout Timeout in milliseconds for waiting for a telegram.
+     *          If the overloaded method without timeout is used, then the default timeout is used.
+     *
+     * \return The message type and the telegram, -1 and an empty telegram if the timeout was reached.
+     * \throws TermConnectionError if the connection was closed, one of the channels was unregistered
+     *          or has a lock-free queue.
+     */
+    std::tuple<int, Telegram> waitForAny(const std::vector<int> &message_types);
+    std::tuple<int, Telegram> waitForAny(const std::vector<int> &message_types, const std::chrono::duration<int, std::milli> timeout);
+
     /** Immediately return the last received telegram.
      *
      * \return The last received telegram or an empty string if no telegram was received or something went wrong.
@@ -190,6 +352,291 @@ public:
                                                 const std::chrono::duration<int, std::milli> timeout,
                                                 int answer_message_typ);
 
+    /** Send a telegram and register for its reply without waiting for it.
+     *
+     *  The replies arriving on the answer channel are assigned to the requests in the order in which the
+     *  requests were sent. Therefore several requests can be sent before the first reply arrives and
+     *  several threads can share the connection without receiving the replies of other threads.
+     *
+     *  If the number of requests waiting for their reply has reached the pipeline depth,
+     *  the method blocks until a reply has arrived.
+     *
+     *  If the connection is closed before the reply arrives, the future throws a TermConnectionError exception.
+     *
+     * \param  payload The actual data which is being sent to Term.
+     * \param  message_type Used internally by the DevCli dll. Depends on context. Most of the time 2.
+     * \param  answer_message_type Message type which is used for the response.
+     *
+     * \return Future which returns the reply telegram.
+     */
+    std::future<std::vector<uint8_t>> sendTelegramWithReply(std::string_view payload, int message_type, int answer_message_type);
+
+    /** Send a telegram and return a token which receives its reply.
+     *
+     *  Without correlation key the reply is assigned like at sendTelegramWithReply. With a correlation key
+     *  the request receives the first telegram on the answer channel which starts with the key, even if
+     *  other requests are waiting before it. Telegrams without matching key are assigned to the requests
+     *  without key. If no request without key waits and only one request with key, it receives the
+     *  telegram, so a reply in an unexpected format does not remain unassigned. Term repeats the command
+     *  and the connection name in some control replies, e.g. the HeartBeat reply starts with
+     *  "1,<connection name>,", so the reply cannot be taken by a request of another thread which does
+     *  not get an answer.
+     *
+     *  Of the requests sent by this library only the HeartBeat request of
+     *  ThalesRemoteScriptWrapper::getWorkstationHeartBeat uses a correlation key. All other requests,
+     *  including all Remote2 commands, receive the replies in the order of the requests.
+     *
+     *  An urgent request does not wait until the number of requests waiting for a reply is below the
+     *  pipeline depth. With the send queue it is also sent before the normal telegrams in the queue and
+     *  its reply is expected before their replies. It does not wait for threads which wait for space in
+     *  the send queue. Without send queue it waits at most for the telegram which is being sent.
+     *
+     * \param  payload The actual data which is being sent to Term.
+     * \param  message_type Used internally by the DevCli dll. Depends on context. Most of the time 2.
+     * \param  answer_message_type Message type which is used for the response.
+     * \param  correlationKey The beginning of the expected reply, empty to take the next reply.
+     * \param  priority The priority of the request.
+     *
+     * \return The token which receives the reply.
+     */
+    ReplyToken sendTelegramWithReplyToken(std::string_view payload, int message_type, int answer_message_type, std::string_view correlationKey = {}, SendPriority priority = SendPriority::NORMAL);
+
+    std::future<std::string> sendStringAndWaitForReplyStringAsync(std::string payload,
+                                                                  int message_type);
+    /** Send a telegram and return immediately, the reply is delivered by the receive thread.
+     *
+     *  The calling thread does not wait for the reply, so one thread can wait for many requests at the same time.
+     *  The replies are assigned to the requests as described at sendTelegramWithReply.
+     *
+     * \param  payload The actual data which is being sent to Term.
+     * \param  message_type Used internally by the DevCli dll. Depends on context. Most of the time 2.
+     * \param  answer_message_type Message type which is used for the response.
+     *          If the overloaded method is used without this parameter, then the send number is used.
+     *
+     * \return Future which returns the reply string.
+     */
+    std::future<std::string> sendStringAndWaitForReplyStringAsync(std::string payload,
+                                                                  int message_type,
+                                                                  int answer_message_type);
+
+    /** Send a telegram and call the callback with the reply.
+     *
+     *  The callback is called by the thread receiving the telegrams. It should return quickly and must
+     *  not wait for other replies of this connection. Exceptions thrown by the callback are ignored.
+     *
+     * \param  payload The actual data which is being sent to Term.
+     * \param  message_type Used internally by the DevCli dll. Depends on context. Most of the time 2.
+     * \param  answer_message_type Message type which is used for the response.
+     * \param  callback Is called with the reply or the error.
+     * \param  priority The priority of the request, see sendTelegramWithReplyToken.
+     */
+    void sendStringAndWaitForReplyStringAsync(std::string payload,
+                                              int message_type,
+                                              int answer_message_type,
+                                              ReplyCallback callback,
+                                              SendPriority priority = SendPriority::NORMAL);
+
+    /** Set the maximum number of requests which wait for their reply at the same time.
+     *
+     *  By default this is 1, each request is sent only after the reply to the previous one has arrived.
+     *  With a larger value, requests are sent before the previous replies have arrived. This saves the
+     *  round trip time for each request if the network has a high latency.
+     *
+     * \param  depth The maximum number of requests waiting for a reply. At least 1.
+     */
+    void setPipelineDepth(int depth);
+
+    /** Send the telegrams by a separate writer thread.
+     *
+     *  The sending threads only copy their telegrams into a send queue and return. The writer thread
+     *  sends all telegrams queued in the meantime with one system call, so many threads sending small
+     *  telegrams do not produce many small TCP segments and do not contend for the socket.
+     *
+     *  Socket errors are no longer reported by the call which queued the telegram, but by the following
+     *  calls. If the queue holds too much data, the sending threads wait for the writer thread.
+     *
+     * \param  enable true to use the writer thread, false to send directly.
+     */
+    void enableSendQueue(bool enable = true);
+
+    /** Read the socket by the waiting thread instead of a receive thread.
+     *
+     *  By default a receive thread reads the socket and passes the telegrams to the waiting threads.
+     *  For sequential scripts, which always wait for the reply of their last command, this costs a thread
+     *  switch per reply. In the inline mode no receive thread is started. The thread which waits in
+     *  waitForTelegram, drain, waitForAny, sendStringAndWaitForReplyString or ReplyToken::get reads
+     *  the socket itself. Telegrams of other channels are put into their queues.
+     *
+     *  Only these waiting methods read the socket. Futures, callbacks, awaitables and subscriptions
+     *  are only served while a thread waits in one of them. Since no thread waits for space, telegrams
+     *  which do not fit into a full queue with the policy BLOCK are discarded.
+     *
+     *  The mode must be set before connectToTerm.
+     *
+     * \param  enable true to read the socket by the waiting thread.
+     */
+    void enableInlineReceive(bool enable = true);
+
+    /** Send the telegrams directly by the calling thread, which is the default.
+     *
+     *  The telegrams in the send queue are sent before the writer thread is stopped.
+     */
+    void disableSendQueue();
+
+    /** Wait for the next telegram of a message type without blocking the calling thread.
+     *
+     *  If a telegram is already in the queue, the callback is called immediately by the calling thread.
+     *  Otherwise it is called when the telegram arrives, see sendStringAndWaitForReplyStringAsync.
+     *
+     * \param  message_type The message type of the telegram.
+     * \param  callback Is called with the telegram or the error.
+     * \throws TermConnectionError if the channel has a lock-free queue.
+     */
+    void waitForTelegramAsync(int message_type, TelegramCallback callback);
+
+    /** Awaitable variant of waitForTelegram for C++20 coroutines.
+     *
+     * \param  message_type The message type of the telegram.
+     * \return Awaitable which returns the telegram.
+     */
+    ThalesAwaitable<std::vector<uint8_t>> waitForTelegramAwaitable(int message_type);
+
+    /** Awaitable variant of sendStringAndWaitForReplyString for C++20 coroutines.
+     *
+     *  The request is sent when the awaitable is awaited with co_await.
+     *
+     * \param  payload The actual data which is being sent to Term.
+     * \param  message_type Used internally by the DevCli dll. Depends on context. Most of the time 2.
+     * \param  answer_message_type Message type which is used for the response.
+     * \return Awaitable which returns the reply string.
+     */
+    ThalesAwaitable<std::string> sendStringAndWaitForReplyStringAwaitable(std::string payload,
+                                                                         int message_type,
+                                                                         int answer_message_type);
+
+    /** Set the executor which calls the callbacks and resumes the coroutines.
+     *
+     *  By default the callbacks are called by the thread receiving the telegrams. A TelegramReactor calls
+     *  them after it released the lock of its connections. With an executor the callbacks may block and
+     *  wait for further replies of this connection.
+     *
+     * \param  executor The executor or nullptr to use the receive thread. Must exist longer than the connection.
+     */
+    void setCallbackExecutor(ThreadPoolExecutor* executor);
+
+    /** Return a telegram buffer after use.
+     *
+     *  The buffers of received telegrams are taken from a pool of the connection. The methods returning
+     *  strings return the buffers themselves. Telegrams returned as vector, e.g. by waitForTelegram, can
+     *  be returned with this method when they are no longer needed, so no memory is allocated for the
+     *  following telegrams. Returning the telegrams is optional.
+     *
+     * \param  telegram The telegram which is moved into the pool.
+     */
+    void releaseTelegram(std::vector<uint8_t> &&telegram);
+    void releaseTelegram(Telegram &&telegram);
+
+    /** Register a channel so that its telegrams are received.
+     *
+     *  By default the channels 2, 128, 129, 130, 131 and 132 are registered. Telegrams of channels
+     *  which are not registered are discarded by the receive thread without being copied.
+     *
+     * \param  message_type The message type of the channel, 0 to 255.
+     */
+    void registerChannel(int message_type);
+
+    /** Unregister a channel whose telegrams are not needed.
+     *
+     *  Threads waiting for telegrams or replies on this channel are released with a TermConnectionError.
+     *
+     * \param  message_type The message type of the channel, 0 to 255.
+     */
+    void unregisterChannel(int message_type);
+
+    /** Check if a channel is registered.
+     *
+     * \param  message_type The message type of the channel.
+     * \return true if telegrams of the channel are received.
+     */
+    bool isChannelRegistered(int message_type) const;
+
+    /** Limit the number of telegrams which are kept in the queue of a channel.
+     *
+     *  By default the queues are unlimited. If the application does not read a channel, e.g. the online
+     *  data during a long measurement, a limit keeps the memory usage constant. With the policy BLOCK the
+     *  receive thread waits until the application has read a telegram, so the telegrams of all channels
+     *  are delayed. The other policies discard telegrams, which are counted.
+     *
+     *  A connection served by a TelegramReactor cannot use the policy BLOCK, because the thread of the
+     *  reactor would also delay the other connections.
+     *
+     * \param  message_type The message type of the channel. The channel must be registered.
+     * \param  capacity Maximum number of telegrams, 0 for unlimited.
+     * \param  overflowPolicy Behaviour when a telegram is received while the queue is full.
+     * \throws TermConnectionError if the policy BLOCK is used with a TelegramReactor.
+     */
+    void setChannelQueueCapacity(int message_type, size_t capacity, TelegramQueue::OverflowPolicy overflowPolicy);
+
+    /** Replace the queue of a channel with a lock-free ring buffer.
+     *
+     *  For channels with a high telegram rate the ring buffer avoids the lock for each telegram. The
+     *  capacity of the ring buffer is fixed and only one thread may wait for telegrams of the channel at
+     *  the same time, so waitForAny and waitForTelegramAsync reject the channel. The queue of a channel
+     *  can be replaced only once.
+     *
+     *  Telegrams in the previous queue are discarded. Threads waiting on it in waitForTelegram or drain
+     *  are released with a TermConnectionError, threads in waitForAny wait on the new queue.
+     *
+     * \param  message_type The message type of the channel. The channel must be registered.
+     * \param  capacity Maximum number of telegrams, at least 1.
+     * \param  waitStrategy How the reading thread and the receive thread wait.
+     * \param  overflowPolicy BLOCK or DROP_NEWEST. With a TelegramReactor only DROP_NEWEST.
+     * \throws TermConnectionError if the policy BLOCK is used with a TelegramReactor or the channel
+     *          already has a lock-free queue.
+     */
+    void setChannelQueueLockFree(int message_type, size_t capacity, LockFreeRingQueue::WaitStrategy waitStrategy = LockFreeRingQueue::WaitStrategy::BLOCK, TelegramQueue::OverflowPolicy overflowPolicy = TelegramQueue::OverflowPolicy::BLOCK);
+
+    /** Get the number of telegrams discarded because the queue of the channel was full.
+     *
+     * \param  message_type The message type of the channel. The channel must be registered.
+     * \return The number of discarded telegrams.
+     */
+    unsigned long getDroppedTelegramCount(int message_type) const;
+
+    /** Subscribe to all telegrams of a channel.
+     *
+     *  The handler is called for each telegram of the channel as soon as it is received, instead of
+     *  putting the telegram into the queue of the channel. Replies to requests and waitForTelegramAsync
+     *  are served first. When the connection is closed, the handler is called with a TermConnectionError.
+     *
+     *  Without executor the handler is called directly by the thread receiving the telegrams. It should
+     *  return quickly and must not wait for replies of this connection. A TelegramReactor calls the handler
+     *  after it released the lock of its connections. With an executor the handler is
+     *  called by the executor, with one executor thread the telegrams are delivered in the order of reception.
+     *  Exceptions thrown by the handler are ignored.
+     *
+     * \param  message_type The message type of the channel. The channel must be registered.
+     * \param  handler Is called with each telegram.
+     * \param  executor The executor which calls the handler or nullptr to call it directly.
+     *          Must exist longer than the subscription.
+     * \return The id of the subscription for unsubscribe.
+     */
+    int subscribe(int message_type, TelegramCallback handler, ThreadPoolExecutor* executor = nullptr);
+
+    /** Cancel a subscription.
+     *
+     *  After this method returned the handler is not called again, except for a call that was already running.
+     *
+     * \param  subscriptionId The id returned by subscribe.
+     */
+    void unsubscribe(int subscriptionId);
+
+    /** Get the maximum number of requests which wait for their reply at the same time.
+     *
+     * \return The pipeline depth.
+     */
+    int getPipelineDepth();
+
     /** Get the used name of the connection.
      *
      * \return The name of the connection.
@@ -218,21 +665,154 @@ public:
      */
     std::chrono::duration<int, std::milli> getTimeout();
 
+    /** Returns the end of a wait with the timeout, time_point::max() if the timeout is unlimited.
+     *
+     *  Methods which wait in several steps compute the deadline once and pass the remaining time to each step.
+     */
+    static std::chrono::steady_clock::time_point deadlineAfter(const std::chrono::duration<int, std::milli> timeout);
+
+    /** Returns the time left until the deadline, at least 0 and unlimited for time_point::max(). */
+    static std::chrono::duration<int, std::milli> timeUntil(const std::chrono::steady_clock::time_point deadline);
+
 protected:
     std::chrono::duration<int, std::milli> defaultTimeout;
 
     static const int term_port = 260;
     std::string connectionName;
 
+    /** Incremented by each connectToTerm, see getConnectionCount. */
+    std::atomic<unsigned long> connectionCount;
+
     SOCKET socket_handle;
 
-    std::vector<int> availableChannels;
+    /** Request which waits for its reply. */
+    class PendingReply
+    {
+    public:
+        std::promise<std::vector<uint8_t>> promise;
+        TelegramCallback completion;
+
+        /** False for timed out requests and for receivers without request. */
+        bool occupiesPipelineSlot = true;
 
-    std::unordered_map<int, std::shared_ptr<ThreadsafeQueue>> queuesForChannels;
+        /** Time after which a cancelled request no longer waits for its late reply and is removed. */
+        std::chrono::steady_clock::time_point expiry = std::chrono::steady_clock::time_point::max();
+
+        /** The channel of the reply. */
+        int answerMessageType = 0;
+
+        /** The beginning of the expected reply, empty for the next reply of the channel. */
+        std::string correlationKey;
+
+        /** Completes the request with the reply or with the error.
+         *
+         *  If an executor is passed, the completion callback is called by the executor.
+         *  In a thread of a TelegramReactor the callback is called after the reactor released its lock.
+         *  The reply is moved into the promise, the executor or the deferred call, otherwise it remains with the caller.
+         */
+        void complete(std::vector<uint8_t> &&reply, std::exception_ptr error, ThreadPoolExecutor* executor = nullptr);
+    };
+
+    /** Handler which receives all telegrams of a channel. */
+    class Subscription : public std::enable_shared_from_this<Subscription>
+    {
+    public:
+        int id;
+        TelegramCallback handler;
+        ThreadPoolExecutor* executor;
+        std::atomic<bool> active;
+
+        /** Calls the handler with the telegram or with the error, directly or by the executor.
+         *
+         *  In a thread of a TelegramReactor the handler is called after the reactor released its lock.
+         */
+        void deliver(const std::vector<uint8_t> &telegram, std::exception_ptr error);
+    };
+
+    using SubscriptionList = std::vector<std::shared_ptr<Subscription>>;
+
+    /** Set by the threads of a TelegramReactor while they hold the lock of their event loop.
+     *
+     *  Callbacks and handlers without executor are collected in the list and called by the reactor
+     *  after the lock was released, so they can use the connection and do not delay the other connections.
+     */
+    static thread_local std::vector<std::function<void()>>* deferredCallbacks;
+
+    std::mutex pendingRepliesMutex;
+    std::condition_variable pipelineSlotAvailable;
+    static const int numberOfChannels = 256;
+
+    std::array<std::deque<std::shared_ptr<PendingReply>>, numberOfChannels> pendingRepliesForChannels;
+    int pendingRepliesCount;
+    int pipelineDepth;
+    bool acceptingReplies;
+    ThreadPoolExecutor* callbackExecutor;
+
+    /** Subscriptions of the channels. The lists are replaced on change, so they can be used without lock. */
+    std::array<std::shared_ptr<const SubscriptionList>, numberOfChannels> subscriptionsForChannels;
+    int nextSubscriptionId;
+
+    /** Serializes the writes of different threads to the socket. */
+    std::mutex sendMutex;
+
+    /** Telegrams with header for the writer thread, in the order in which they are sent. */
+    std::vector<char> sendQueueData;
+
+    /** Urgent telegrams, which the writer thread sends before the normal telegrams. */
+    std::vector<char> urgentSendQueueData;
+
+    /** Number of registered requests of each answer channel whose telegrams are in sendQueueData.
+     *  Urgent requests are registered before them, because they are sent before them.
+     */
+    std::array<int, numberOfChannels> queuedRequestsForChannels;
+    std::mutex sendQueueMutex;
+    std::condition_variable sendQueueDataAvailable;
+    std::condition_variable sendQueueSpaceAvailable;
+    bool sendQueueEnabled;
+    bool sendQueueRunning;
+    bool sendQueueBusy;
+    bool sendQueueFailed;
+    std::thread *sendWorker;
+
+    /** A memory area to be sent. */
+    struct SendBuffer
+    {
+        const char *data;
+        size_t size;
+    };
+
+    /** Queues of the registered channels indexed by the message type, nullptr for unregistered channels. */
+    std::array<std::atomic<TelegramQueue*>, numberOfChannels> channelTable;
+
+    /** Owner of the queues. Queues are kept after unregistering, because threads may still access them. */
+    std::array<std::unique_ptr<TelegramQueue>, numberOfChannels> channelQueues;
+
+    /** Queues replaced by setChannelQueueLockFree, kept because threads may still access them. */
+    std::array<std::unique_ptr<TelegramQueue>, numberOfChannels> retiredQueues;
+    std::mutex channelRegistrationMutex;
+
+    /** Wakes the threads in waitForAny when a telegram was put into a queue. */
+    std::mutex anyTelegramMutex;
+    std::condition_variable anyTelegramAvailable;
+    std::atomic<int> anyTelegramWaiters;
+    unsigned long anyTelegramSequence;
 
     bool receiving_worker_is_running;
     std::thread *receivingWorker;
 
+    /** If true, the waiting threads read the socket instead of the receivingWorker. */
+    bool inlineReceive;
+    std::mutex inlineReceiveMutex;
+
+    TelegramReactor* reactor;
+
+    std::vector<uint8_t> receiveBuffer;
+    size_t receiveBufferStart;
+    size_t receiveBufferFill;
+
+    /** Buffers for the received telegrams, which are moved to the receivers and returned after use. */
+    TelegramBufferPool telegramPool;
+
     /** The method running in a separate thread, pushing the incomming packets into the queue. */
     void telegramListenerJob();
 
@@ -244,15 +824,213 @@ protected:
 
     /** Reads the raw telegram structure from the socket stream.
      *
-     *  If the connection was disconnected, an empty array is returned.
+     *  The data is read from the socket in large blocks into the receive buffer. As long as complete
+     *  telegrams are in the buffer, they are returned without reading from the socket again.
+     *
+     *  If the connection was disconnected, an empty telegram with message type -1 is returned.
      */
-    std::tuple<int, std::vector<uint8_t>> readTelegramFromSocket();
+    Telegram readTelegramFromSocket();
+
+    /** Wakes the threads in waitForAny after a telegram was put into a queue. */
+    void notifyAnyTelegramWaiters();
+
+    /** Waits until the condition on the queues is true or the deadline has passed.
+     *
+     *  Used by waitForAny, the threads are woken by notifyAnyTelegramWaiters.
+     *
+     * \return The value of the condition.
+     */
+    template <typename Condition>
+    bool waitForAnyTelegram(Condition condition, const std::chrono::steady_clock::time_point deadline);
+
+    /** Reads the socket once in the calling thread and dispatches the complete telegrams.
+     *
+     *  Used in the inline receive mode. Only one thread reads the socket at a time. A thread which had
+     *  to wait for another reading thread returns without reading, so it can check for its telegram.
+     *
+     * \param timeout The maximum time to wait for data.
+     * \return false if the connection was closed.
+     */
+    bool receiveInline(const std::chrono::duration<int, std::milli> timeout);
+
+    /** Reads the socket in the calling thread until the condition is true or the timeout expired.
+     *
+     * \return The value of the condition.
+     */
+    template <typename Condition>
+    bool waitInline(Condition condition, const std::chrono::duration<int, std::milli> timeout);
+
+    /** Reads as much data as possible from the socket into the free part of the receive buffer.
+     *
+     * \param flags The flags for the recv function.
+     * \return The return value of the recv function.
+     */
+    long receiveIntoBuffer(int flags);
+
+    /** Reads all data currently available on the socket without blocking.
+     *
+     *  Used by the TelegramReactor. All complete telegrams are taken from the receive buffer and put
+     *  into the queues, incomplete telegrams remain in the buffer until the next call.
+     *
+     * \return false if the connection was closed or an error occurred.
+     */
+    bool receiveAvailableTelegrams();
+
+    /** Takes the next complete telegram from the receive buffer.
+     *
+     *  Telegrams of unregistered channels are skipped.
+     *
+     * \return true if a complete telegram was available.
+     */
+    bool extractTelegramFromBuffer(Telegram &telegram);
+
+    /** Returns the queue of a registered channel or throws a TermConnectionError. */
+    TelegramQueue* getQueueForChannel(int message_type) const;
+
+    /** Puts a received telegram into the queue of its channel. */
+    void dispatchTelegram(Telegram &&telegram);
+
+    /** Passes the telegram to its receiver.
+     *
+     * \return false if the queue of the channel was full and the telegram must be dispatched again.
+     */
+    bool dispatchTelegramOrWait(Telegram &telegram);
+
+    /** Interrupts or resumes waiting for space in full queues. */
+    void setQueuesInterrupted(bool interrupted);
+
+    /** Throws a TermConnectionError if the queue could make the thread of a reactor wait. */
+    void checkOverflowPolicy(size_t capacity, TelegramQueue::OverflowPolicy overflowPolicy) const;
+
+    /** Throws a TermConnectionError if the queue of the channel may only be read by one thread. */
+    void checkSharedReading(int message_type, const TelegramQueue* queue) const;
+
+    /** Puts empty telegrams into all queues to free the threads waiting for telegrams. */
+    void releaseWaitingReceivers();
 
     /** Helper function getting the current time in milliseconds. */
     std::chrono::milliseconds getCurrentTimeInMilliseconds() const;
 
     void closeSocket();
 
+    /** Registers a request for its reply and sends it.
+     *
+     * \return The registered request.
+     */
+    std::shared_ptr<PendingReply> submitRequest(std::string_view payload, int message_type, int answer_message_type, std::shared_ptr<PendingReply> request = nullptr, SendPriority priority = SendPriority::NORMAL);
+
+    /** Releases the pipeline slot of a request which is no longer awaited.
+     *
+     *  The request remains registered so that its late reply is not assigned to the next request.
+     *  If the reply does not arrive within the expiry time, the request is removed, so a command
+     *  which Term never answers does not shift the replies of all following requests.
+     *
+     * \param request The request which is no longer awaited.
+     * \param expiryTime Time to wait for the late reply, the maximum to wait until the connection is closed.
+     */
+    void cancelRequest(const std::shared_ptr<PendingReply> &request, const std::chrono::duration<int, std::milli> expiryTime);
+
+    /** Removes the request which receives the telegram from the pending requests of the channel.
+     *
+     *  A request whose correlation key matches the telegram is preferred to the first request without key.
+     *  If there is neither, a single waiting request with key receives the telegram.
+     *  Cancelled requests whose expiry time has passed are removed before.
+     *  The caller must hold the pendingRepliesMutex.
+     *
+     * \return The request or nullptr if no request receives the telegram.
+     */
+    std::shared_ptr<PendingReply> takePendingReply(int message_type, std::span<const uint8_t> telegram);
+
+    /** Writes a telegram directly to the socket. The caller must hold the sendMutex and the send queue must be disabled. */
+    void writeTelegram(std::span<const std::byte> payload, int message_type);
+
+    /** Adds a telegram to the send queue and registers its request in the order of sending.
+     *
+     *  The sendMutex is not needed, so a thread waiting here for space does not block urgent telegrams.
+     *
+     * \param request The request waiting for the reply or nullptr.
+     * \param answer_message_type The channel of the reply, if a request is passed.
+     * \return false if the send queue is not enabled, then the telegram must be written directly.
+     */
+    bool queueTelegram(std::span<const std::byte> payload, int message_type, SendPriority priority, const std::shared_ptr<PendingReply> &request = nullptr, int answer_message_type = 0);
+
+    /** The method running in the writer thread, sending the content of the send queue. */
+    void sendQueueJob();
+
+    /** Waits until the writer thread has sent all queued telegrams. */
+    void flushSendQueue();
+
+    /** Sends the memory areas one after the other with vectored writes.
+     *
+     *  The write is repeated until all data has been sent. The buffers are advanced while sending.
+     *
+     * \param buffers The memory areas to send.
+     * \param numberOfBuffers The number of memory areas.
+     * \return false if a socket error occurred.
+     */
+    bool sendBuffers(SendBuffer *buffers, size_t numberOfBuffers);
+
+    /** Creates the socket and connects it to Term.
+     *
+     *  If the timeout is not the maximum, the connection is established non-blocking and
+     *  aborted after the timeout.
+     *
+     * \param address The hostname or ip-address of the host running Term.
+     * \param timeout Timeout in milliseconds for establishing the connection.
+     */
+    void openSocket(const std::string &address, const std::chrono::duration<int, std::milli> timeout);
+
+    /** Sends the packet which registers the connection name at Term. */
+    void sendRegistrationPacket();
+
+};
+
+class ZenniumConnection::ReplyToken
+{
+public:
+    ReplyToken(ZenniumConnection* connection, std::shared_ptr<PendingReply> request);
+    ReplyToken(ReplyToken &&other) = default;
+    ReplyToken& operator=(ReplyToken &&other);
+
+    /** Cancels the request if its reply was not taken with get, see cancel. */
+    ~ReplyToken();
+
+    /** Wait for the reply.
+     *
+     *  After a timeout the request is cancelled. Its late reply is discarded if it arrives within
+     *  the timeout once more, afterwards the next reply goes to the next request.
+     *
+     * \param  timeout Timeout in milliseconds for waiting for the reply.
+     * \return The reply telegram.
+     * \throws TermConnectionError after a timeout or if the connection was closed.
+     */
+    std::vector<uint8_t> get(const std::chrono::duration<int, std::milli> timeout = std::chrono::duration<int, std::milli>::max());
+
+    /** Wait for the reply and return it as string.
+     *
+     * \param  timeout Timeout in milliseconds for waiting for the reply.
+     * \return The reply telegram as string.
+     * \throws TermConnectionError after a timeout or if the connection was closed.
+     */
+    std::string getString(const std::chrono::duration<int, std::milli> timeout = std::chrono::duration<int, std::milli>::max());
+
+    /** Check if the reply has arrived.
+     *
+     * \return true if get returns without waiting.
+     */
+    bool isReady() const;
+
+    /** Stop waiting for the reply.
+     *
+     *  The reply is discarded when it arrives and the request no longer counts towards the pipeline depth.
+     *  If the reply does not arrive within the default timeout of the connection, the request is removed.
+     */
+    void cancel();
+
+private:
+    ZenniumConnection* connection;
+    std::shared_ptr<PendingReply> request;
+    std::future<std::vector<uint8_t>> reply;
 };
 
 #endif // THALESREMOTECONNECTION_H
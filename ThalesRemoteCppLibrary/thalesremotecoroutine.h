@@ -0,0 +1,261 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef THALESREMOTECOROUTINE_H
+#define THALESREMOTECOROUTINE_H
+
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <future>
+#include <optional>
+
+/** Awaitable for an asynchronous operation of the Thales remote interface.
+ *
+ *  The awaitable is returned by the ...Awaitable methods of ZenniumConnection and ThalesRemoteScriptWrapper.
+ *  The operation is started when the awaitable is awaited with co_await. The coroutine is suspended
+ *  without blocking a thread and is resumed when the reply has arrived.
+ *
+ *  The coroutine is resumed by the receive thread of the connection or, if one is set, by the
+ *  executor of the connection (see ZenniumConnection::setCallbackExecutor). Without executor, the coroutine
+ *  must not call blocking methods of the same connection.
+ */
+template <typename T>
+class ThalesAwaitable
+{
+public:
+
+    /** Callback which completes the operation. */
+    using Completion = std::function<void(T result, std::exception_ptr error)>;
+
+    /** Function which starts the operation and calls the completion when it is finished. */
+    using Operation = std::function<void(Completion completion)>;
+
+    explicit ThalesAwaitable(Operation operation) :
+        operation(std::move(operation)),
+        state(State::STARTING)
+    {
+
+    }
+
+    ThalesAwaitable(ThalesAwaitable &&other) :
+        operation(std::move(other.operation)),
+        state(State::STARTING)
+    {
+
+    }
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    bool await_suspend(std::coroutine_handle<> handle)
+    {
+        this->handle = handle;
+
+        this->operation([this](T result, std::exception_ptr error) {
+            if (error)
+            {
+                this->error = error;
+            }
+            else
+            {
+                this->result.emplace(std::move(result));
+            }
+
+            /*
+             * If the operation is completed before await_suspend returned,
+             * the coroutine is not suspended instead of being resumed recursively.
+             */
+            if (this->state.exchange(State::COMPLETED) == State::SUSPENDED)
+            {
+                this->handle.resume();
+            }
+        });
+
+        return this->state.exchange(State::SUSPENDED) != State::COMPLETED;
+    }
+
+    T await_resume()
+    {
+        if (this->error)
+        {
+            std::rethrow_exception(this->error);
+        }
+        return std::move(*this->result);
+    }
+
+private:
+
+    enum class State
+    {
+        STARTING,
+        SUSPENDED,
+        COMPLETED
+    };
+
+    Operation operation;
+    std::coroutine_handle<> handle;
+    std::atomic<State> state;
+    std::optional<T> result;
+    std::exception_ptr error;
+};
+
+/** Return type for coroutines that use the Thales remote interface.
+ *
+ *  The coroutine starts immediately when it is called and runs until it waits for the first reply.
+ *  The result of the coroutine, or the exception it threw, is returned by get().
+ *
+ *  Example:
+ *  \code
+ *  ThalesTask<double> measure(ThalesRemoteScriptWrapper &device)
+ *  {
+ *      co_await device.setFrequencyAwaitable(1000);
+ *      auto impedance = co_await device.getImpedanceAwaitable();
+ *      co_return std::abs(impedance);
+ *  }
+ *  \endcode
+ */
+template <typename T = void>
+class ThalesTask
+{
+public:
+
+    class promise_type
+    {
+    public:
+        std::promise<T> result;
+
+        ThalesTask get_return_object()
+        {
+            return ThalesTask(this->result.get_future());
+        }
+
+        std::suspend_never initial_suspend() noexcept
+        {
+            return {};
+        }
+
+        std::suspend_never final_suspend() noexcept
+        {
+            return {};
+        }
+
+        void return_value(T value)
+        {
+            this->result.set_value(std::move(value));
+        }
+
+        void unhandled_exception()
+        {
+            this->result.set_exception(std::current_exception());
+        }
+    };
+
+    /** Blocks until the coroutine has finished and returns its result. */
+    T get()
+    {
+        return this->future.get();
+    }
+
+    /** Access to the future of the result, e.g. to wait with a timeout. */
+    std::future<T>& getFuture()
+    {
+        return this->future;
+    }
+
+private:
+
+    explicit ThalesTask(std::future<T> future) :
+        future(std::move(future))
+    {
+
+    }
+
+    std::future<T> future;
+};
+
+template <>
+class ThalesTask<void>
+{
+public:
+
+    class promise_type
+    {
+    public:
+        std::promise<void> result;
+
+        ThalesTask get_return_object()
+        {
+            return ThalesTask(this->result.get_future());
+        }
+
+        std::suspend_never initial_suspend() noexcept
+        {
+            return {};
+        }
+
+        std::suspend_never final_suspend() noexcept
+        {
+            return {};
+        }
+
+        void return_void()
+        {
+            this->result.set_value();
+        }
+
+        void unhandled_exception()
+        {
+            this->result.set_exception(std::current_exception());
+        }
+    };
+
+    /** Blocks until the coroutine has finished. */
+    void get()
+    {
+        this->future.get();
+    }
+
+    /** Access to the future of the result, e.g. to wait with a timeout. */
+    std::future<void>& getFuture()
+    {
+        return this->future;
+    }
+
+private:
+
+    explicit ThalesTask(std::future<void> future) :
+        future(std::move(future))
+    {
+
+    }
+
+    std::future<void> future;
+};
+
+#endif // THALESREMOTECOROUTINE_H
@@ -26,64 +26,44 @@
 
 #include "thalesremotescriptwrapper.h"
 #include <algorithm>
-#include <iomanip>
 #include <sstream>
+#include <tuple>
+#include <utility>
 #include "termconnectionerror.h"
 #include "thalesremoteerror.h"
+#include "remotecommandencoder.h"
+#include "replyparser.h"
 
 template <typename T>
 std::string to_string_with_precision(const T value, const int n = 6) {
-    std::stringstream out;
-    out << std::scientific << std::setprecision(n) << value;
-    return out.str();
-}
-
-std::vector<int> tokenize(const std::string& str, char delim) {
-    std::vector<int> tokens;
-    std::stringstream ss(str);
-    std::string token;
-    while (std::getline(ss, token, delim)) {
-        tokens.push_back(std::stoi(token));
-    }
-    return tokens;
-}
-
-int compareVersions(const std::string& version1, const std::string& version2) {
-    std::vector<int> v1 = tokenize(version1, '.');
-    std::vector<int> v2 = tokenize(version2, '.');
-    size_t i;
-    for (i = 0; i < v1.size() && i < v2.size(); ++i) {
-        if (v1[i] < v2[i]) {
-            return -1;
-        } else if (v1[i] > v2[i]) {
-            return 1;
-        }
-    }
-    if (v1.size() < v2.size()) {
-        return -1;
-    } else if (v1.size() > v2.size()) {
-        return 1;
-    } else {
-        return 0;
-    }
+    RemoteCommandEncoder out;
+    out.appendScientific(value, n);
+    return std::string(out.view());
 }
 
-const std::string MINIMUM_THALES_VERSION = "5.9.2";
+const std::array<int, 3> MINIMUM_THALES_VERSION = {5, 9, 2};
+
+static int potentialRelationToInt(PotentialRelation relation) {
+    return (relation == PotentialRelation::RELATIVE_RELATED) ? -1 : 0;
+}
 
 ThalesRemoteScriptWrapper::ThalesRemoteScriptWrapper(ZenniumConnection* const remoteConnection) :
-    remoteConnection(remoteConnection) {
+    remoteConnection(remoteConnection),
+    parameterBatchOpen(false),
+    parameterCacheEnabled(false),
+    ruleFileInUse(false),
+    parameterCacheConnection(remoteConnection->getConnectionCount()),
+    parameterCacheHits(0),
+    parameterCacheMisses(0) {
     bool versionOk = true;
 
     try {
         const auto versionReply = getThalesVersion();
         if (versionReply.find("devel") == std::string::npos) {
-            std::regex replyStringPattern("(\\d+.\\d+.\\d+)");
-            std::smatch match;
+            std::array<int, 3> version;
 
-            if (std::regex_search(versionReply, match, replyStringPattern)) {
-                const std::string versionString = match[0];
-                const auto compResult           = compareVersions(versionString, MINIMUM_THALES_VERSION);
-                if (compResult == -1) {
+            if (ReplyParser::parseVersion(versionReply, version)) {
+                if (version < MINIMUM_THALES_VERSION) {
                     versionOk = false;
                 }
             } else {
@@ -100,10 +80,234 @@ ThalesRemoteScriptWrapper::ThalesRemoteScriptWrapper(ZenniumConnection* const re
 }
 
 std::string ThalesRemoteScriptWrapper::executeRemoteCommand(std::string command) {
+    this->prepareRemoteCommand(command);
     return remoteConnection->sendStringAndWaitForReplyString("1:" + command + ":", 2);
 }
 
+std::vector<std::string> ThalesRemoteScriptWrapper::executeRemoteCommands(const std::vector<std::string>& commands) {
+    std::vector<ZenniumConnection::ReplyToken> pendingReplies;
+    pendingReplies.reserve(commands.size());
+
+    for (const auto& command : commands) {
+        this->prepareRemoteCommand(command);
+        pendingReplies.push_back(remoteConnection->sendTelegramWithReplyToken("1:" + command + ":", 2, 2));
+    }
+
+    std::vector<std::string> replies;
+    replies.reserve(commands.size());
+
+    for (auto& pendingReply : pendingReplies) {
+        replies.push_back(pendingReply.getString(remoteConnection->getTimeout()));
+    }
+
+    return replies;
+}
+
+void ThalesRemoteScriptWrapper::beginParameterBatch() {
+    this->parameterBatchOpen = true;
+}
+
+std::vector<ThalesRemoteScriptWrapper::ParameterResult> ThalesRemoteScriptWrapper::commitParameterBatch() {
+    this->sendParameterBatch();
+    this->parameterBatchOpen = false;
+
+    std::vector<ParameterResult> results;
+    results.swap(this->parameterBatchResults);
+    return results;
+}
+
+void ThalesRemoteScriptWrapper::flushParameterBatch() {
+    if (this->parameterBatch.empty() == true) {
+        return;
+    }
+
+    // The results remain in the batch, errors are reported by commitParameterBatch and not by the following command.
+    this->sendParameterBatch();
+}
+
+std::string ThalesRemoteScriptWrapper::sendParameterBatch(const std::string& command) {
+    std::vector<std::string> commands;
+    commands.swap(this->parameterBatch);
+
+    const size_t firstIndex         = this->parameterBatchResults.size();
+    const size_t numberOfParameters = commands.size();
+    if (command.empty() == false) {
+        this->invalidateParameterCache(command);
+        commands.push_back(command);
+    }
+
+    // Telegrams "1:<command>:<command>:...:", firstCommands holds the index of the first command of each telegram.
+    std::vector<ZenniumConnection::ReplyToken> pendingReplies;
+    std::vector<size_t> firstCommands;
+    std::string payload;
+
+    for (size_t index = 0; index < commands.size(); index++) {
+        if (payload.empty() == false && payload.size() + commands[index].size() + 1 > 0xFFFF) {
+            pendingReplies.push_back(remoteConnection->sendTelegramWithReplyToken(payload, 2, 2));
+            payload.clear();
+        }
+        if (payload.empty() == true) {
+            firstCommands.push_back(index);
+            payload = "1:";
+        }
+        payload += commands[index] + ":";
+    }
+    if (payload.empty() == false) {
+        pendingReplies.push_back(remoteConnection->sendTelegramWithReplyToken(payload, 2, 2));
+    }
+    firstCommands.push_back(commands.size());
+
+    std::string reply;
+    std::vector<ParameterResult> results(numberOfParameters);
+    std::vector<size_t> rejectedParameters;
+
+    for (size_t telegram = 0; telegram < pendingReplies.size(); telegram++) {
+        reply             = pendingReplies[telegram].getString(remoteConnection->getTimeout());
+        const bool success = reply.find("ERROR") == std::string::npos;
+
+        for (size_t index = firstCommands[telegram]; index < std::min(firstCommands[telegram + 1], numberOfParameters); index++) {
+            results[index] = {commands[index], reply, success, firstIndex + index};
+            if (success == false) {
+                rejectedParameters.push_back(index);
+            }
+        }
+    }
+
+    /*
+     * The device replies once to a command list and does not tell which command failed. The parameters
+     * of a rejected list are sent again one per telegram, which does not change the accepted ones, so
+     * each parameter gets its own reply.
+     */
+    std::vector<ZenniumConnection::ReplyToken> singleReplies;
+    for (size_t index : rejectedParameters) {
+        singleReplies.push_back(remoteConnection->sendTelegramWithReplyToken("1:" + commands[index] + ":", 2, 2));
+    }
+    for (size_t parameter = 0; parameter < rejectedParameters.size(); parameter++) {
+        auto& result   = results[rejectedParameters[parameter]];
+        result.reply   = singleReplies[parameter].getString(remoteConnection->getTimeout());
+        result.success = result.reply.find("ERROR") == std::string::npos;
+    }
+
+    for (auto& result : results) {
+        const auto separator = result.command.find('=');
+        if (result.success == true && separator != std::string::npos && result.command.find(':') == std::string::npos) {
+            this->storeInParameterCache(
+                result.command.substr(0, separator), result.command.substr(separator + 1), result.reply
+            );
+        }
+        this->parameterBatchResults.push_back(std::move(result));
+    }
+
+    return (command.empty() == true) ? std::string() : reply;
+}
+
+void ThalesRemoteScriptWrapper::prepareRemoteCommand(std::string_view command) {
+    this->flushParameterBatch();
+    this->invalidateParameterCache(command);
+}
+
+void ThalesRemoteScriptWrapper::addToParameterBatch(std::string command) {
+    // The value is not known to the device until the batch is committed.
+    this->invalidateParameterCache(command);
+    this->parameterBatch.push_back(std::move(command));
+}
+
+void ThalesRemoteScriptWrapper::enableParameterCache(bool enabled) {
+    this->clearParameterCache();
+    this->parameterCacheEnabled = enabled;
+}
+
+void ThalesRemoteScriptWrapper::disableParameterCache() {
+    this->enableParameterCache(false);
+}
+
+void ThalesRemoteScriptWrapper::clearParameterCache() {
+    this->parameterCache.clear();
+    this->parameterCacheConnection = remoteConnection->getConnectionCount();
+}
+
+unsigned long ThalesRemoteScriptWrapper::getParameterCacheHits() const {
+    return this->parameterCacheHits;
+}
+
+unsigned long ThalesRemoteScriptWrapper::getParameterCacheMisses() const {
+    return this->parameterCacheMisses;
+}
+
+/** Parameters which select the device or the rules for all other parameters. */
+static bool isSelectingParameter(std::string_view name) {
+    return name == "DEV%" || name == "DEVHOT%" || name == "UseRuleFile";
+}
+
+/** Commands which only read values and do not change any parameter. */
+static bool isReadOnlyCommand(std::string_view command) {
+    for (std::string_view readOnly : {"IMPEDANCE", "PAD4IMP", "CURRENT", "POTENTIAL", "ANALOGIN", "ANALOGALL", "ALLNUM"}) {
+        if (command == readOnly) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThalesRemoteScriptWrapper::invalidateParameterCache(std::string_view command) {
+    if (this->parameterCache.empty() == true) {
+        return;
+    }
+
+    while (command.empty() == false) {
+        const auto end      = command.find(':');
+        const auto single   = command.substr(0, end);
+        const auto assigned = single.find('=');
+
+        if (assigned != std::string_view::npos) {
+            const auto name = single.substr(0, assigned);
+            if (isSelectingParameter(name) == true) {
+                this->parameterCache.clear();
+                return;
+            }
+
+            const auto cached = this->parameterCache.find(name);
+            if (cached != this->parameterCache.end()) {
+                this->parameterCache.erase(cached);
+            }
+        } else if (isReadOnlyCommand(single) == false) {
+            // Measurements, SENDSETUP and unknown commands can change any parameter.
+            this->parameterCache.clear();
+            return;
+        }
+
+        command = (end == std::string_view::npos) ? std::string_view() : command.substr(end + 1);
+    }
+}
+
+const ThalesRemoteScriptWrapper::CachedParameter* ThalesRemoteScriptWrapper::findInParameterCache(
+    std::string_view name, std::string_view value
+) {
+    if (this->parameterCacheEnabled == false) {
+        return nullptr;
+    }
+
+    if (this->parameterCacheConnection != remoteConnection->getConnectionCount()) {
+        this->clearParameterCache();
+    }
+
+    const auto cached = this->parameterCache.find(name);
+    if (cached != this->parameterCache.end() && cached->second.value == value) {
+        this->parameterCacheHits++;
+        return &cached->second;
+    }
+    this->parameterCacheMisses++;
+    return nullptr;
+}
+
+void ThalesRemoteScriptWrapper::storeInParameterCache(std::string_view name, std::string_view value, const std::string& reply) {
+    if (this->parameterCacheEnabled == true && this->ruleFileInUse == false && isSelectingParameter(name) == false) {
+        this->parameterCache[std::string(name)] = {std::string(value), reply};
+    }
+}
+
 std::string ThalesRemoteScriptWrapper::forceThalesIntoRemoteScript() {
+    this->clearParameterCache();
     remoteConnection->sendStringAndWaitForReplyString(
         "3," + this->remoteConnection->getConnectionName() + ",0,OFF", 128
     );
@@ -131,45 +335,34 @@ std::string ThalesRemoteScriptWrapper::getThalesVersion() {
         throw ThalesRemoteError(reply);
     }
 
-    std::regex replyStringPattern(".*?,.*?,(.*)");
-    std::smatch match;
+    std::string_view version;
 
-    std::regex_search(reply, match, replyStringPattern);
-
-    if (match.size() < 1) {
+    if (ReplyParser::getControlReplyValue(reply, version) == false) {
         throw ThalesRemoteError("Error with the serial number.");
     }
 
-    return match.str(1);
+    return std::string(version);
 }
 
 int ThalesRemoteScriptWrapper::getWorkstationHeartBeat() {
-    auto reply =
-        remoteConnection->sendStringAndWaitForReplyString("1," + this->remoteConnection->getConnectionName(), 128);
-    int result = -1;
+    // The reply repeats the command, so it cannot be taken by a control request of another thread.
+    auto reply = remoteConnection->sendTelegramWithReplyToken(
+        "1," + this->remoteConnection->getConnectionName(), 128, 128, "1," + this->remoteConnection->getConnectionName() + ","
+    ).getString();
 
     if (reply.find("ERROR") != std::string::npos) {
         throw ThalesRemoteError(reply);
     }
 
-    std::regex replyStringPattern("^\\S*,\\S*,([\\d]*)$");
-    std::smatch match;
-
-    std::regex_search(reply, match, replyStringPattern);
-
-    if (match.size() > 1) {
-        result = this->stringToInt(match.str(1));
-    }
-
-    return result;
+    return ReplyParser::parseHeartBeat(reply);
 }
 
 double ThalesRemoteScriptWrapper::getCurrent() {
-    return this->requestValueAndParseUsingRegexp("CURRENT", std::regex("current=\\s*(.*?)A"));
+    return this->requestValueAndParse("CURRENT", "current=", "A");
 }
 
 double ThalesRemoteScriptWrapper::getPotential() {
-    return this->requestValueAndParseUsingRegexp("POTENTIAL", std::regex("potential=\\s*(.*?)V"));
+    return this->requestValueAndParse("POTENTIAL", "potential=", "V");
 }
 
 double ThalesRemoteScriptWrapper::getVoltage() {
@@ -177,19 +370,19 @@ double ThalesRemoteScriptWrapper::getVoltage() {
 }
 
 std::string ThalesRemoteScriptWrapper::setCurrent(double current) {
-    return this->setValue("Cset", current);
+    return this->setParameter<RemoteParameter::CURRENT>(current);
 }
 
 std::string ThalesRemoteScriptWrapper::setPotential(double potential) {
-    return this->setValue("Pset", potential);
+    return this->setParameter<RemoteParameter::POTENTIAL>(potential);
 }
 
 std::string ThalesRemoteScriptWrapper::setMaximumShuntIndex(int shunt) {
-    return this->setValue("Rmax", shunt);
+    return this->setParameter<RemoteParameter::MAXIMUM_SHUNT_INDEX>(shunt);
 }
 
 std::string ThalesRemoteScriptWrapper::setMinimumShuntIndex(int shunt) {
-    return this->setValue("Rmin", shunt);
+    return this->setParameter<RemoteParameter::MINIMUM_SHUNT_INDEX>(shunt);
 }
 
 std::string ThalesRemoteScriptWrapper::setShuntIndex(int index) {
@@ -198,15 +391,15 @@ std::string ThalesRemoteScriptWrapper::setShuntIndex(int index) {
 }
 
 std::string ThalesRemoteScriptWrapper::setVoltageRangeIndex(int index) {
-    return this->setValue("Potrange", index);
+    return this->setParameter<RemoteParameter::VOLTAGE_RANGE_INDEX>(index);
 }
 
 std::string ThalesRemoteScriptWrapper::selectPotentiostat(int device) {
-    return this->setValue("DEV%", device);
+    return this->setParameter<RemoteParameter::POTENTIOSTAT>(device);
 }
 
 std::string ThalesRemoteScriptWrapper::selectPotentiostatWithoutPotentiostatStateChange(int device) {
-    return this->setValue("DEVHOT%", device);
+    return this->setParameter<RemoteParameter::POTENTIOSTAT_WITHOUT_STATE_CHANGE>(device);
 }
 
 std::string ThalesRemoteScriptWrapper::switchToSCPIControl() {
@@ -218,33 +411,13 @@ std::string ThalesRemoteScriptWrapper::switchToSCPIControlWithoutPotentiostatSta
 }
 
 std::string ThalesRemoteScriptWrapper::getSerialNumber() {
-    std::string retval = "";
-    std::string reply  = this->executeRemoteCommand("ALLNUM");
-
-    std::regex replyStringPattern("(.*);(.*);([a-zA-Z]*)");
-    std::smatch match;
-
-    std::regex_search(reply, match, replyStringPattern);
-
-    if (match.size() > 3) {
-        retval = match.str(2);
-    }
-    return retval;
+    std::string reply = this->executeRemoteCommand("ALLNUM");
+    return std::string(ReplyParser::getDeviceField(reply, 0));
 }
 
 std::string ThalesRemoteScriptWrapper::getDeviceName() {
-    std::string retval = "";
-    std::string reply  = this->executeRemoteCommand("ALLNUM");
-
-    std::regex replyStringPattern("(.*);(.*);([a-zA-Z]*)");
-    std::smatch match;
-
-    std::regex_search(reply, match, replyStringPattern);
-
-    if (match.size() > 3) {
-        retval = match.str(3);
-    }
-    return retval;
+    std::string reply = this->executeRemoteCommand("ALLNUM");
+    return std::string(ReplyParser::getDeviceField(reply, 1));
 }
 
 std::string ThalesRemoteScriptWrapper::readSetup() {
@@ -259,7 +432,14 @@ std::string ThalesRemoteScriptWrapper::enablePotentiostat(bool enabled) {
     if (enabled == true) {
         return this->executeRemoteCommand("Pot=-1");
     } else {
-        return this->executeRemoteCommand("Pot=0");
+        RemoteCommandEncoder command;
+        command.append("Pot=0").frame();
+
+        // Switching off is sent before the commands which are still waiting to be sent.
+        this->invalidateParameterCache("Pot=0");
+        return remoteConnection->sendTelegramWithReplyToken(
+            command.view(), 2, 2, {}, ZenniumConnection::SendPriority::URGENT
+        ).getString(remoteConnection->getTimeout());
     }
 }
 
@@ -285,11 +465,18 @@ std::string ThalesRemoteScriptWrapper::setPotentiostatMode(PotentiostatMode pote
             break;
     }
 
+    if (this->parameterBatchOpen == true) {
+        this->addToParameterBatch(command);
+        return "";
+    }
+
     return this->executeRemoteCommand(command);
 }
 
 std::string ThalesRemoteScriptWrapper::enableRuleFileUsage(bool enabled) {
-    return this->setValue("UseRuleFile", enabled);
+    auto reply          = this->setParameter<RemoteParameter::RULE_FILE_USAGE>(enabled);
+    this->ruleFileInUse = enabled;
+    return reply;
 }
 
 std::string ThalesRemoteScriptWrapper::disableRuleFileUsage() {
@@ -349,11 +536,11 @@ std::string ThalesRemoteScriptWrapper::setupPad4ModeGlobal(Pad4Mode mode) {
             intmode = 1;
             break;
     }
-    return this->setValue("PAD4MOD", intmode);
+    return this->setParameter<RemoteParameter::PAD4_MODE>(intmode);
 }
 
 std::string ThalesRemoteScriptWrapper::enablePad4Global(bool enabled) {
-    return this->setValue("PAD4ENA", enabled);
+    return this->setParameter<RemoteParameter::PAD4_ENABLED>(enabled);
 }
 
 std::string ThalesRemoteScriptWrapper::disablePad4Global() {
@@ -371,53 +558,43 @@ std::string ThalesRemoteScriptWrapper::readPAD4Setup() {
 }
 
 std::string ThalesRemoteScriptWrapper::setFrequency(double frequency) {
-    return this->setValue("Frq", frequency);
+    return this->setParameter<RemoteParameter::FREQUENCY>(frequency);
 }
 
 std::string ThalesRemoteScriptWrapper::setAmplitude(double amplitude) {
-    return this->setValue("Ampl", amplitude * 1e3);
+    return this->setParameter<RemoteParameter::AMPLITUDE>(amplitude);
 }
 
 std::string ThalesRemoteScriptWrapper::setNumberOfPeriods(int numberOfPeriods) {
-    // little bits of stability
-
-    if (numberOfPeriods > 100) {
-        numberOfPeriods = 100;
-    }
-
-    if (numberOfPeriods < 1) {
-        numberOfPeriods = 1;
-    }
-
-    return this->setValue("Nw", numberOfPeriods);
+    return this->setParameter<RemoteParameter::NUMBER_OF_PERIODS>(numberOfPeriods);
 }
 
 std::string ThalesRemoteScriptWrapper::setUpperFrequencyLimit(double frequency) {
-    return this->setValue("Fmax", frequency);
+    return this->setParameter<RemoteParameter::UPPER_FREQUENCY_LIMIT>(frequency);
 }
 
 std::string ThalesRemoteScriptWrapper::setLowerFrequencyLimit(double frequency) {
-    return this->setValue("Fmin", frequency);
+    return this->setParameter<RemoteParameter::LOWER_FREQUENCY_LIMIT>(frequency);
 }
 
 std::string ThalesRemoteScriptWrapper::setStartFrequency(double frequency) {
-    return this->setValue("Fstart", frequency);
+    return this->setParameter<RemoteParameter::START_FREQUENCY>(frequency);
 }
 
 std::string ThalesRemoteScriptWrapper::setUpperStepsPerDecade(int steps) {
-    return this->setValue("dfm", steps);
+    return this->setParameter<RemoteParameter::UPPER_STEPS_PER_DECADE>(steps);
 }
 
 std::string ThalesRemoteScriptWrapper::setLowerStepsPerDecade(int steps) {
-    return this->setValue("dfl", steps);
+    return this->setParameter<RemoteParameter::LOWER_STEPS_PER_DECADE>(steps);
 }
 
 std::string ThalesRemoteScriptWrapper::setUpperNumberOfPeriods(int periods) {
-    return this->setValue("Nws", periods);
+    return this->setParameter<RemoteParameter::UPPER_NUMBER_OF_PERIODS>(periods);
 }
 
 std::string ThalesRemoteScriptWrapper::setLowerNumberOfPeriods(int periods) {
-    return this->setValue("Nwl", periods);
+    return this->setParameter<RemoteParameter::LOWER_NUMBER_OF_PERIODS>(periods);
 }
 
 std::string ThalesRemoteScriptWrapper::setScanStrategy(ScanStrategy strategy) {
@@ -434,7 +611,7 @@ std::string ThalesRemoteScriptWrapper::setScanStrategy(ScanStrategy strategy) {
             strategyInt = 2;
             break;
     }
-    return this->setValue("ScanStrategy", strategyInt);
+    return this->setParameter<RemoteParameter::SCAN_STRATEGY>(strategyInt);
 }
 
 std::string ThalesRemoteScriptWrapper::setScanDirection(ScanDirection direction) {
@@ -448,27 +625,19 @@ std::string ThalesRemoteScriptWrapper::setScanDirection(ScanDirection direction)
             directionInt = 1;
             break;
     }
-    return this->setValue("ScanDirection", directionInt);
+    return this->setParameter<RemoteParameter::SCAN_DIRECTION>(directionInt);
 }
 
 std::complex<double> ThalesRemoteScriptWrapper::getImpedance() {
-    std::complex<double> result(std::nan("1"), std::nan("1"));
-
-    std::string reply = this->executeRemoteCommand("IMPEDANCE");
+    return this->parseImpedance(this->executeRemoteCommand("IMPEDANCE"));
+}
 
+std::complex<double> ThalesRemoteScriptWrapper::parseImpedance(const std::string& reply) {
     if (reply.find("ERROR") != std::string::npos) {
         throw ThalesRemoteError(reply);
     }
 
-    std::regex replyStringPattern("impedance=\\s*(.*?),\\s*(.*?)\\\r");
-    std::smatch match;
-    std::regex_search(reply, match, replyStringPattern);
-
-    if (match.size() > 2) {
-        result = std::complex<double>(this->stringToDobule(match.str(1)), this->stringToDobule(match.str(2)));
-    }
-
-    return result;
+    return ReplyParser::parseImpedance(reply);
 }
 
 std::complex<double> ThalesRemoteScriptWrapper::getImpedance(double frequency) {
@@ -478,11 +647,30 @@ std::complex<double> ThalesRemoteScriptWrapper::getImpedance(double frequency) {
 }
 
 std::complex<double> ThalesRemoteScriptWrapper::getImpedance(double frequency, double amplitude, int numberOfPeriods) {
-    this->setFrequency(frequency);
-    this->setAmplitude(amplitude);
-    this->setNumberOfPeriods(numberOfPeriods);
+    const bool batchWasOpen = this->parameterBatchOpen;
 
-    return this->getImpedance();
+    // Parameters of an open batch are sent before, so their errors are only reported by commitParameterBatch.
+    this->flushParameterBatch();
+    const size_t batchResults = this->parameterBatchResults.size();
+
+    // A setter rejecting its value must not leave the batch open with the parameters set before.
+    this->parameterBatchOpen = true;
+    try {
+        this->setFrequency(frequency);
+        this->setAmplitude(amplitude);
+        this->setNumberOfPeriods(numberOfPeriods);
+    } catch (...) {
+        this->parameterBatch.clear();
+        this->parameterBatchOpen = batchWasOpen;
+        throw;
+    }
+    this->parameterBatchOpen = batchWasOpen;
+
+    // The parameters and the IMPEDANCE command are sent in one telegram.
+    const auto reply = this->sendParameterBatch("IMPEDANCE");
+    this->parameterBatchResults.erase(this->parameterBatchResults.begin() + batchResults, this->parameterBatchResults.end());
+
+    return this->parseImpedance(reply);
 }
 
 std::string ThalesRemoteScriptWrapper::getImpedancePad4() {
@@ -523,20 +711,20 @@ std::string ThalesRemoteScriptWrapper::setEISNaming(NamingRule naming) {
             namingInt = 2;
             break;
     }
-    return this->setValue("EIS_MOD", namingInt);
+    return this->setParameter<RemoteParameter::EIS_NAMING>(namingInt);
 }
 
 std::string ThalesRemoteScriptWrapper::setEISCounter(int number) {
-    return this->setValue("EIS_NUM", number);
+    return this->setParameter<RemoteParameter::EIS_COUNTER>(number);
 }
 
 std::string ThalesRemoteScriptWrapper::setEISOutputPath(std::string path) {
     transform(path.begin(), path.end(), path.begin(), ::tolower);
-    return this->setValue("EIS_PATH", path);
+    return this->setParameter<RemoteParameter::EIS_OUTPUT_PATH>(path);
 }
 
 std::string ThalesRemoteScriptWrapper::setEISOutputFileName(std::string name) {
-    return this->setValue("EIS_ROOT", name);
+    return this->setParameter<RemoteParameter::EIS_OUTPUT_FILE_NAME>(name);
 }
 
 std::string ThalesRemoteScriptWrapper::measureEIS() {
@@ -550,55 +738,55 @@ std::string ThalesRemoteScriptWrapper::measureEIS() {
 }
 
 std::string ThalesRemoteScriptWrapper::setCVStartPotential(double potential) {
-    return this->setValue("CV_Pstart", potential);
+    return this->setParameter<RemoteParameter::CV_START_POTENTIAL>(potential);
 }
 
 std::string ThalesRemoteScriptWrapper::setCVUpperReversingPotential(double potential) {
-    return this->setValue("CV_Pupper", potential);
+    return this->setParameter<RemoteParameter::CV_UPPER_REVERSING_POTENTIAL>(potential);
 }
 
 std::string ThalesRemoteScriptWrapper::setCVLowerReversingPotential(double potential) {
-    return this->setValue("CV_Plower", potential);
+    return this->setParameter<RemoteParameter::CV_LOWER_REVERSING_POTENTIAL>(potential);
 }
 
 std::string ThalesRemoteScriptWrapper::setCVEndPotential(double potential) {
-    return this->setValue("CV_Pend", potential);
+    return this->setParameter<RemoteParameter::CV_END_POTENTIAL>(potential);
 }
 
 std::string ThalesRemoteScriptWrapper::setCVStartHoldTime(double time) {
-    return this->setValue("CV_Tstart", time);
+    return this->setParameter<RemoteParameter::CV_START_HOLD_TIME>(time);
 }
 
 std::string ThalesRemoteScriptWrapper::setCVEndHoldTime(double time) {
-    return this->setValue("CV_Tend", time);
+    return this->setParameter<RemoteParameter::CV_END_HOLD_TIME>(time);
 }
 
 std::string ThalesRemoteScriptWrapper::setCVScanRate(double scanRate) {
-    return this->setValue("CV_Srate", scanRate);
+    return this->setParameter<RemoteParameter::CV_SCAN_RATE>(scanRate);
 }
 
 std::string ThalesRemoteScriptWrapper::setCVCycles(double cycles) {
-    return this->setValue("CV_Periods", cycles);
+    return this->setParameter<RemoteParameter::CV_CYCLES>(cycles);
 }
 
 std::string ThalesRemoteScriptWrapper::setCVSamplesPerCycle(double samples) {
-    return this->setValue("CV_PpPer", samples);
+    return this->setParameter<RemoteParameter::CV_SAMPLES_PER_CYCLE>(samples);
 }
 
 std::string ThalesRemoteScriptWrapper::setCVMaximumCurrent(double current) {
-    return this->setValue("CV_Ima", current);
+    return this->setParameter<RemoteParameter::CV_MAXIMUM_CURRENT>(current);
 }
 
 std::string ThalesRemoteScriptWrapper::setCVMinimumCurrent(double current) {
-    return this->setValue("CV_Imi", current);
+    return this->setParameter<RemoteParameter::CV_MINIMUM_CURRENT>(current);
 }
 
 std::string ThalesRemoteScriptWrapper::setCVOhmicDrop(double ohmicDrop) {
-    return this->setValue("CV_Odrop", ohmicDrop);
+    return this->setParameter<RemoteParameter::CV_OHMIC_DROP>(ohmicDrop);
 }
 
 std::string ThalesRemoteScriptWrapper::enableCVAutoRestartAtCurrentOverflow(bool enabled) {
-    return this->setValue("CV_AutoReStart", enabled);
+    return this->setParameter<RemoteParameter::CV_AUTO_RESTART_AT_CURRENT_OVERFLOW>(enabled);
 }
 
 std::string ThalesRemoteScriptWrapper::disableCVAutoRestartAtCurrentOverflow() {
@@ -606,7 +794,7 @@ std::string ThalesRemoteScriptWrapper::disableCVAutoRestartAtCurrentOverflow() {
 }
 
 std::string ThalesRemoteScriptWrapper::enableCVAutoRestartAtCurrentUnderflow(bool enabled) {
-    return this->setValue("CV_AutoScale", enabled);
+    return this->setParameter<RemoteParameter::CV_AUTO_RESTART_AT_CURRENT_UNDERFLOW>(enabled);
 }
 
 std::string ThalesRemoteScriptWrapper::disableCVAutoRestartAtCurrentUnderflow() {
@@ -614,7 +802,7 @@ std::string ThalesRemoteScriptWrapper::disableCVAutoRestartAtCurrentUnderflow()
 }
 
 std::string ThalesRemoteScriptWrapper::enableCVAnalogFunctionGenerator(bool enabled) {
-    return this->setValue("CV_AFGena", enabled);
+    return this->setParameter<RemoteParameter::CV_ANALOG_FUNCTION_GENERATOR>(enabled);
 }
 
 std::string ThalesRemoteScriptWrapper::disableCVAnalogFunctionGenerator() {
@@ -635,20 +823,20 @@ std::string ThalesRemoteScriptWrapper::setCVNaming(NamingRule naming) {
             namingInt = 2;
             break;
     }
-    return this->setValue("CV_MOD", namingInt);
+    return this->setParameter<RemoteParameter::CV_NAMING>(namingInt);
 }
 
 std::string ThalesRemoteScriptWrapper::setCVCounter(int number) {
-    return this->setValue("CV_NUM", number);
+    return this->setParameter<RemoteParameter::CV_COUNTER>(number);
 }
 
 std::string ThalesRemoteScriptWrapper::setCVOutputPath(std::string path) {
     transform(path.begin(), path.end(), path.begin(), ::tolower);
-    return this->setValue("CV_PATH", path);
+    return this->setParameter<RemoteParameter::CV_OUTPUT_PATH>(path);
 }
 
 std::string ThalesRemoteScriptWrapper::setCVOutputFileName(std::string name) {
-    return this->setValue("CV_ROOT", name);
+    return this->setParameter<RemoteParameter::CV_OUTPUT_FILE_NAME>(name);
 }
 
 std::string ThalesRemoteScriptWrapper::checkCVSetup() {
@@ -682,59 +870,59 @@ std::string ThalesRemoteScriptWrapper::measureCV() {
 }
 
 std::string ThalesRemoteScriptWrapper::setIEFirstEdgePotential(double potential) {
-    return this->setValue("IE_EckPot1", potential);
+    return this->setParameter<RemoteParameter::IE_FIRST_EDGE_POTENTIAL>(potential);
 }
 
 std::string ThalesRemoteScriptWrapper::setIESecondEdgePotential(double potential) {
-    return this->setValue("IE_EckPot2", potential);
+    return this->setParameter<RemoteParameter::IE_SECOND_EDGE_POTENTIAL>(potential);
 }
 
 std::string ThalesRemoteScriptWrapper::setIEThirdEdgePotential(double potential) {
-    return this->setValue("IE_EckPot3", potential);
+    return this->setParameter<RemoteParameter::IE_THIRD_EDGE_POTENTIAL>(potential);
 }
 
 std::string ThalesRemoteScriptWrapper::setIEFourthEdgePotential(double potential) {
-    return this->setValue("IE_EckPot4", potential);
+    return this->setParameter<RemoteParameter::IE_FOURTH_EDGE_POTENTIAL>(potential);
 }
 
 std::string ThalesRemoteScriptWrapper::setIEFirstEdgePotentialRelation(PotentialRelation relation) {
-    return this->setValue("IE_EckPot1rel", relation);
+    return this->setParameter<RemoteParameter::IE_FIRST_EDGE_POTENTIAL_RELATION>(potentialRelationToInt(relation));
 }
 
 std::string ThalesRemoteScriptWrapper::setIESecondEdgePotentialRelation(PotentialRelation relation) {
-    return this->setValue("IE_EckPot2rel", relation);
+    return this->setParameter<RemoteParameter::IE_SECOND_EDGE_POTENTIAL_RELATION>(potentialRelationToInt(relation));
 }
 
 std::string ThalesRemoteScriptWrapper::setIEThirdEdgePotentialRelation(PotentialRelation relation) {
-    return this->setValue("IE_EckPot3rel", relation);
+    return this->setParameter<RemoteParameter::IE_THIRD_EDGE_POTENTIAL_RELATION>(potentialRelationToInt(relation));
 }
 
 std::string ThalesRemoteScriptWrapper::setIEFourthEdgePotentialRelation(PotentialRelation relation) {
-    return this->setValue("IE_EckPot4rel", relation);
+    return this->setParameter<RemoteParameter::IE_FOURTH_EDGE_POTENTIAL_RELATION>(potentialRelationToInt(relation));
 }
 
 std::string ThalesRemoteScriptWrapper::setIEPotentialResolution(double resolution) {
-    return this->setValue("IE_Resolution", resolution);
+    return this->setParameter<RemoteParameter::IE_POTENTIAL_RESOLUTION>(resolution);
 }
 
 std::string ThalesRemoteScriptWrapper::setIEMinimumWaitingTime(double time) {
-    return this->setValue("IE_WZmin", time);
+    return this->setParameter<RemoteParameter::IE_MINIMUM_WAITING_TIME>(time);
 }
 
 std::string ThalesRemoteScriptWrapper::setIEMaximumWaitingTime(double time) {
-    return this->setValue("IE_WZmax", time);
+    return this->setParameter<RemoteParameter::IE_MAXIMUM_WAITING_TIME>(time);
 }
 
 std::string ThalesRemoteScriptWrapper::setIERelativeTolerance(double tolerance) {
-    return this->setValue("IE_Torel", tolerance);
+    return this->setParameter<RemoteParameter::IE_RELATIVE_TOLERANCE>(tolerance);
 }
 
 std::string ThalesRemoteScriptWrapper::setIEAbsoluteTolerance(double tolerance) {
-    return this->setValue("IE_Toabs", tolerance);
+    return this->setParameter<RemoteParameter::IE_ABSOLUTE_TOLERANCE>(tolerance);
 }
 
 std::string ThalesRemoteScriptWrapper::setIEOhmicDrop(double ohmicDrop) {
-    return this->setValue("IE_Odrop", ohmicDrop);
+    return this->setParameter<RemoteParameter::IE_OHMIC_DROP>(ohmicDrop);
 }
 
 std::string ThalesRemoteScriptWrapper::setIESweepMode(IESweepMode sweepMode) {
@@ -751,19 +939,19 @@ std::string ThalesRemoteScriptWrapper::setIESweepMode(IESweepMode sweepMode) {
             sweepModeInt = 0;
             break;
     }
-    return this->setValue("IE_SweepMode", sweepModeInt);
+    return this->setParameter<RemoteParameter::IE_SWEEP_MODE>(sweepModeInt);
 }
 
 std::string ThalesRemoteScriptWrapper::setIEScanRate(double scanRate) {
-    return this->setValue("IE_Srate", scanRate);
+    return this->setParameter<RemoteParameter::IE_SCAN_RATE>(scanRate);
 }
 
 std::string ThalesRemoteScriptWrapper::setIEMaximumCurrent(double current) {
-    return this->setValue("IE_Ima", current);
+    return this->setParameter<RemoteParameter::IE_MAXIMUM_CURRENT>(current);
 }
 
 std::string ThalesRemoteScriptWrapper::setIEMinimumCurrent(double current) {
-    return this->setValue("IE_Imi", current);
+    return this->setParameter<RemoteParameter::IE_MINIMUM_CURRENT>(current);
 }
 
 std::string ThalesRemoteScriptWrapper::setIENaming(NamingRule naming) {
@@ -780,20 +968,20 @@ std::string ThalesRemoteScriptWrapper::setIENaming(NamingRule naming) {
             namingInt = 2;
             break;
     }
-    return this->setValue("IE_MOD", namingInt);
+    return this->setParameter<RemoteParameter::IE_NAMING>(namingInt);
 }
 
 std::string ThalesRemoteScriptWrapper::setIECounter(int number) {
-    return this->setValue("IE_NUM", number);
+    return this->setParameter<RemoteParameter::IE_COUNTER>(number);
 }
 
 std::string ThalesRemoteScriptWrapper::setIEOutputPath(std::string path) {
     transform(path.begin(), path.end(), path.begin(), ::tolower);
-    return this->setValue("IE_PATH", path);
+    return this->setParameter<RemoteParameter::IE_OUTPUT_PATH>(path);
 }
 
 std::string ThalesRemoteScriptWrapper::setIEOutputFileName(std::string name) {
-    return this->setValue("IE_ROOT", name);
+    return this->setParameter<RemoteParameter::IE_OUTPUT_FILE_NAME>(name);
 }
 
 std::string ThalesRemoteScriptWrapper::checkIESetup() {
@@ -850,24 +1038,24 @@ std::string ThalesRemoteScriptWrapper::setSequenceNaming(NamingRule naming) {
             namingInt = 2;
             break;
     }
-    return this->setValue("SEQ_MOD", namingInt);
+    return this->setParameter<RemoteParameter::SEQUENCE_NAMING>(namingInt);
 }
 
 std::string ThalesRemoteScriptWrapper::setSequenceCounter(int number) {
-    return this->setValue("SEQ_NUM", number);
+    return this->setParameter<RemoteParameter::SEQUENCE_COUNTER>(number);
 }
 
 std::string ThalesRemoteScriptWrapper::setSequenceOutputPath(std::string path) {
     transform(path.begin(), path.end(), path.begin(), ::tolower);
-    return this->setValue("SEQ_PATH", path);
+    return this->setParameter<RemoteParameter::SEQUENCE_OUTPUT_PATH>(path);
 }
 
 std::string ThalesRemoteScriptWrapper::setSequenceOutputFileName(std::string name) {
-    return this->setValue("SEQ_ROOT", name);
+    return this->setParameter<RemoteParameter::SEQUENCE_OUTPUT_FILE_NAME>(name);
 }
 
 std::string ThalesRemoteScriptWrapper::enableSequenceAcqGlobal(bool state) {
-    return this->setValue("SEQ_ACQENA", state == true ? -1 : 0);
+    return this->setParameter<RemoteParameter::SEQUENCE_ACQ_ENABLED>(state == true ? -1 : 0);
 }
 
 std::string ThalesRemoteScriptWrapper::disableSequenceAcqGlobal() {
@@ -904,43 +1092,43 @@ std::string ThalesRemoteScriptWrapper::runSequence() {
 }
 
 std::string ThalesRemoteScriptWrapper::setSequenceOhmicDrop(double value) {
-    return this->setValue("SEQ_RODROP", value);
+    return this->setParameter<RemoteParameter::SEQUENCE_OHMIC_DROP>(value);
 }
 
 std::string ThalesRemoteScriptWrapper::setSequenceMaximumRuntime(double value) {
-    return this->setValue("SEQ_MAXTIME", value);
+    return this->setParameter<RemoteParameter::SEQUENCE_MAXIMUM_RUNTIME>(value);
 }
 
 std::string ThalesRemoteScriptWrapper::setSequenceUpperPotentialLimit(double value) {
-    return this->setValue("SEQ_EUPPER", value);
+    return this->setParameter<RemoteParameter::SEQUENCE_UPPER_POTENTIAL_LIMIT>(value);
 }
 
 std::string ThalesRemoteScriptWrapper::setSequenceLowerPotentialLimit(double value) {
-    return this->setValue("SEQ_ELOWER", value);
+    return this->setParameter<RemoteParameter::SEQUENCE_LOWER_POTENTIAL_LIMIT>(value);
 }
 
 std::string ThalesRemoteScriptWrapper::setSequenceUpperCurrentLimit(double value) {
-    return this->setValue("SEQ_IUPPER", value);
+    return this->setParameter<RemoteParameter::SEQUENCE_UPPER_CURRENT_LIMIT>(value);
 }
 
 std::string ThalesRemoteScriptWrapper::setSequenceLowerCurrentLimit(double value) {
-    return this->setValue("SEQ_ILOWER", value);
+    return this->setParameter<RemoteParameter::SEQUENCE_LOWER_CURRENT_LIMIT>(value);
 }
 
 std::string ThalesRemoteScriptWrapper::setSequenceCurrentRange(double value) {
-    return this->setValue("SEQ_IRANGE", value);
+    return this->setParameter<RemoteParameter::SEQUENCE_CURRENT_RANGE>(value);
 }
 
 std::string ThalesRemoteScriptWrapper::setSequencePotentialLatencyWindow(double value) {
-    return this->setValue("SEQ_POTOFLO", value);
+    return this->setParameter<RemoteParameter::SEQUENCE_POTENTIAL_LATENCY_WINDOW>(value);
 }
 
 std::string ThalesRemoteScriptWrapper::setSequenceCurrentLatencyWindow(double value) {
-    return this->setValue("SEQ_CUROFLO", value);
+    return this->setParameter<RemoteParameter::SEQUENCE_CURRENT_LATENCY_WINDOW>(value);
 }
 
 std::string ThalesRemoteScriptWrapper::enableFraMode(bool enabled) {
-    return this->setValue("FRA", enabled);
+    return this->setParameter<RemoteParameter::FRA_MODE>(enabled);
 }
 
 std::string ThalesRemoteScriptWrapper::disableFraMode() {
@@ -948,51 +1136,51 @@ std::string ThalesRemoteScriptWrapper::disableFraMode() {
 }
 
 std::string ThalesRemoteScriptWrapper::setFraVoltageInputGain(double value) {
-    return this->setValue("FRA_POT_IN", value);
+    return this->setParameter<RemoteParameter::FRA_VOLTAGE_INPUT_GAIN>(value);
 }
 
 std::string ThalesRemoteScriptWrapper::setFraVoltageInputOffset(double value) {
-    return this->setValue("FRA_POT_IN_OFF", value);
+    return this->setParameter<RemoteParameter::FRA_VOLTAGE_INPUT_OFFSET>(value);
 }
 
 std::string ThalesRemoteScriptWrapper::setFraVoltageOutputGain(double value) {
-    return this->setValue("FRA_POT_OUT", value);
+    return this->setParameter<RemoteParameter::FRA_VOLTAGE_OUTPUT_GAIN>(value);
 }
 
 std::string ThalesRemoteScriptWrapper::setFraVoltageOutputOffset(double value) {
-    return this->setValue("FRA_POT_OUT_OFF", value);
+    return this->setParameter<RemoteParameter::FRA_VOLTAGE_OUTPUT_OFFSET>(value);
 }
 
 std::string ThalesRemoteScriptWrapper::setFraVoltageMinimum(double value) {
-    return this->setValue("FRA_POT_MIN", value);
+    return this->setParameter<RemoteParameter::FRA_VOLTAGE_MINIMUM>(value);
 }
 
 std::string ThalesRemoteScriptWrapper::setFraVoltageMaximum(double value) {
-    return this->setValue("FRA_POT_MAX", value);
+    return this->setParameter<RemoteParameter::FRA_VOLTAGE_MAXIMUM>(value);
 }
 
 std::string ThalesRemoteScriptWrapper::setFraCurrentInputGain(double value) {
-    return this->setValue("FRA_CUR_IN", value);
+    return this->setParameter<RemoteParameter::FRA_CURRENT_INPUT_GAIN>(value);
 }
 
 std::string ThalesRemoteScriptWrapper::setFraCurrentInputOffset(double value) {
-    return this->setValue("FRA_CUR_IN_OFF", value);
+    return this->setParameter<RemoteParameter::FRA_CURRENT_INPUT_OFFSET>(value);
 }
 
 std::string ThalesRemoteScriptWrapper::setFraCurrentOutputGain(double value) {
-    return this->setValue("FRA_CUR_OUT", value);
+    return this->setParameter<RemoteParameter::FRA_CURRENT_OUTPUT_GAIN>(value);
 }
 
 std::string ThalesRemoteScriptWrapper::setFraCurrentOutputOffset(double value) {
-    return this->setValue("FRA_CUR_OUT_OFF", value);
+    return this->setParameter<RemoteParameter::FRA_CURRENT_OUTPUT_OFFSET>(value);
 }
 
 std::string ThalesRemoteScriptWrapper::setFraCurrentMinimum(double value) {
-    return this->setValue("FRA_CUR_MIN", value);
+    return this->setParameter<RemoteParameter::FRA_CURRENT_MINIMUM>(value);
 }
 
 std::string ThalesRemoteScriptWrapper::setFraCurrentMaximum(double value) {
-    return this->setValue("FRA_CUR_MAX", value);
+    return this->setParameter<RemoteParameter::FRA_CURRENT_MAXIMUM>(value);
 }
 
 std::string ThalesRemoteScriptWrapper::setFraPotentiostatMode(PotentiostatMode potentiostatMode) {
@@ -1032,8 +1220,8 @@ std::string ThalesRemoteScriptWrapper::readAllAcqChannels() {
 }
 
 double ThalesRemoteScriptWrapper::readAcqChannel(int channel) {
-    this->setValue("CHANNEL", channel);
-    return this->requestValueAndParseUsingRegexp("ANALOGIN", std::regex("=[\\s]*(.*)"));
+    this->setParameter<RemoteParameter::ACQ_CHANNEL>(channel);
+    return this->requestValueAndParse("ANALOGIN", "=");
 }
 
 
@@ -1049,68 +1237,409 @@ std::string ThalesRemoteScriptWrapper::disableAcq() {
     return this->enableAcq(false);
 }
 
+std::future<std::string> ThalesRemoteScriptWrapper::executeRemoteCommandAsync(std::string command) {
+    this->prepareRemoteCommand(command);
+    return remoteConnection->sendStringAndWaitForReplyStringAsync("1:" + command + ":", 2);
+}
+
+void ThalesRemoteScriptWrapper::executeRemoteCommandAsync(std::string command, ZenniumConnection::ReplyCallback callback,
+                                                          ZenniumConnection::SendPriority priority) {
+    if (priority == ZenniumConnection::SendPriority::NORMAL) {
+        this->prepareRemoteCommand(command);
+    } else {
+        // Urgent commands overtake the open batch, only the cache is updated.
+        this->invalidateParameterCache(command);
+    }
+    remoteConnection->sendStringAndWaitForReplyStringAsync("1:" + command + ":", 2, 2, callback, priority);
+}
+
+std::future<double> ThalesRemoteScriptWrapper::getCurrentAsync() {
+    return this->requestAsync<double>("CURRENT", [this](const std::string& reply) {
+        return this->parseValue(reply, "current=", "A");
+    });
+}
+
+std::future<double> ThalesRemoteScriptWrapper::getPotentialAsync() {
+    return this->requestAsync<double>("POTENTIAL", [this](const std::string& reply) {
+        return this->parseValue(reply, "potential=", "V");
+    });
+}
+
+std::future<double> ThalesRemoteScriptWrapper::getVoltageAsync() {
+    return this->getPotentialAsync();
+}
+
+std::future<std::complex<double>> ThalesRemoteScriptWrapper::getImpedanceAsync() {
+    return this->requestAsync<std::complex<double>>("IMPEDANCE", [this](const std::string& reply) {
+        return this->parseImpedance(reply);
+    });
+}
+
+std::future<std::string> ThalesRemoteScriptWrapper::setCurrentAsync(double current) {
+    return this->requestAsync<std::string>(encodeParameter<RemoteParameter::CURRENT>(current), checkReplyForError);
+}
+
+std::future<std::string> ThalesRemoteScriptWrapper::setPotentialAsync(double potential) {
+    return this->requestAsync<std::string>(encodeParameter<RemoteParameter::POTENTIAL>(potential), checkReplyForError);
+}
+
+std::future<std::string> ThalesRemoteScriptWrapper::setFrequencyAsync(double frequency) {
+    return this->requestAsync<std::string>(encodeParameter<RemoteParameter::FREQUENCY>(frequency), checkReplyForError);
+}
+
+std::future<std::string> ThalesRemoteScriptWrapper::setAmplitudeAsync(double amplitude) {
+    return this->requestAsync<std::string>(encodeParameter<RemoteParameter::AMPLITUDE>(amplitude), checkReplyForError);
+}
+
+std::future<std::string> ThalesRemoteScriptWrapper::setNumberOfPeriodsAsync(int numberOfPeriods) {
+    return this->requestAsync<std::string>(encodeParameter<RemoteParameter::NUMBER_OF_PERIODS>(numberOfPeriods), checkReplyForError);
+}
+
+std::future<std::string> ThalesRemoteScriptWrapper::enablePotentiostatAsync(bool enabled) {
+    auto reply = [](const std::string& reply) {
+        return reply;
+    };
+
+    if (enabled == true) {
+        return this->requestAsync<std::string>("Pot=-1", reply);
+    } else {
+        // Switching off is sent before the commands which are still waiting to be sent.
+        return this->requestAsync<std::string>("Pot=0", reply, ZenniumConnection::SendPriority::URGENT);
+    }
+}
+
+std::future<std::string> ThalesRemoteScriptWrapper::disablePotentiostatAsync() {
+    return this->enablePotentiostatAsync(false);
+}
+
+ThalesAwaitable<std::string> ThalesRemoteScriptWrapper::executeRemoteCommandAwaitable(std::string command) {
+    this->prepareRemoteCommand(command);
+    return remoteConnection->sendStringAndWaitForReplyStringAwaitable("1:" + command + ":", 2, 2);
+}
+
+ThalesAwaitable<double> ThalesRemoteScriptWrapper::getCurrentAwaitable() {
+    return this->requestAwaitable<double>("CURRENT", [this](const std::string& reply) {
+        return this->parseValue(reply, "current=", "A");
+    });
+}
+
+ThalesAwaitable<double> ThalesRemoteScriptWrapper::getPotentialAwaitable() {
+    return this->requestAwaitable<double>("POTENTIAL", [this](const std::string& reply) {
+        return this->parseValue(reply, "potential=", "V");
+    });
+}
+
+ThalesAwaitable<double> ThalesRemoteScriptWrapper::getVoltageAwaitable() {
+    return this->getPotentialAwaitable();
+}
+
+ThalesAwaitable<std::complex<double>> ThalesRemoteScriptWrapper::getImpedanceAwaitable() {
+    return this->requestAwaitable<std::complex<double>>("IMPEDANCE", [this](const std::string& reply) {
+        return this->parseImpedance(reply);
+    });
+}
+
+ThalesAwaitable<std::string> ThalesRemoteScriptWrapper::setCurrentAwaitable(double current) {
+    return this->requestAwaitable<std::string>(encodeParameter<RemoteParameter::CURRENT>(current), checkReplyForError);
+}
+
+ThalesAwaitable<std::string> ThalesRemoteScriptWrapper::setPotentialAwaitable(double potential) {
+    return this->requestAwaitable<std::string>(encodeParameter<RemoteParameter::POTENTIAL>(potential), checkReplyForError);
+}
+
+ThalesAwaitable<std::string> ThalesRemoteScriptWrapper::setFrequencyAwaitable(double frequency) {
+    return this->requestAwaitable<std::string>(encodeParameter<RemoteParameter::FREQUENCY>(frequency), checkReplyForError);
+}
+
+ThalesAwaitable<std::string> ThalesRemoteScriptWrapper::setAmplitudeAwaitable(double amplitude) {
+    return this->requestAwaitable<std::string>(encodeParameter<RemoteParameter::AMPLITUDE>(amplitude), checkReplyForError);
+}
+
+ThalesAwaitable<std::string> ThalesRemoteScriptWrapper::setNumberOfPeriodsAwaitable(int numberOfPeriods) {
+    return this->requestAwaitable<std::string>(encodeParameter<RemoteParameter::NUMBER_OF_PERIODS>(numberOfPeriods), checkReplyForError);
+}
+
+ThalesAwaitable<std::string> ThalesRemoteScriptWrapper::enablePotentiostatAwaitable(bool enabled) {
+    auto reply = [](const std::string& reply) {
+        return reply;
+    };
+
+    if (enabled == true) {
+        return this->requestAwaitable<std::string>("Pot=-1", reply);
+    } else {
+        // Switching off is sent before the commands which are still waiting to be sent.
+        return this->requestAwaitable<std::string>("Pot=0", reply, ZenniumConnection::SendPriority::URGENT);
+    }
+}
+
+ThalesAwaitable<std::string> ThalesRemoteScriptWrapper::disablePotentiostatAwaitable() {
+    return this->enablePotentiostatAwaitable(false);
+}
+
 /*
  * protected/internal Methods
  */
 
 
 std::string ThalesRemoteScriptWrapper::setValue(std::string name, PotentialRelation relation) {
-    int relationInt;
+    return this->setValue(name, potentialRelationToInt(relation));
+}
 
-    if (relation == PotentialRelation::RELATIVE_RELATED) {
-        relationInt = -1;
-    } else {
-        relationInt = 0;
-    }
+std::string ThalesRemoteScriptWrapper::setValue(std::string name, bool value) {
+    int enable = (value == true) ? 1 : 0;
+    return this->setValue(name, std::to_string(enable));
+}
+
+std::string ThalesRemoteScriptWrapper::setValue(std::string name, double value) {
+    return this->setValue(name, to_string_with_precision(value, 10));
+}
 
-    return this->setValue(name, relationInt);
+std::string ThalesRemoteScriptWrapper::setValue(std::string name, int value) {
+    return this->setValue(name, std::to_string(value));
 }
 
-std::string ThalesRemoteScriptWrapper::setValue(std::string name, bool value) {
-    int enable        = (value == true) ? 1 : 0;
-    std::string reply = this->executeRemoteCommand(name + "=" + std::to_string(enable));
+std::string ThalesRemoteScriptWrapper::setValue(std::string name, std::string value) {
+    if (const auto cached = this->findInParameterCache(name, value)) {
+        return cached->reply;
+    }
+
+    if (this->parameterBatchOpen == true) {
+        this->addToParameterBatch(name + "=" + value);
+        return "";
+    }
+
+    std::string reply = this->executeRemoteCommand(name + "=" + value);
 
     if (reply.find("ERROR") != std::string::npos) {
         throw ThalesRemoteError(reply);
     }
 
+    this->storeInParameterCache(name, value, reply);
     return reply;
 }
 
-std::string ThalesRemoteScriptWrapper::setValue(std::string name, double value) {
-    std::string reply = this->executeRemoteCommand(name + "=" + to_string_with_precision(value, 10));
+/** Assigns a parameter of the table to the public method which sets it. */
+template <RemoteParameter parameter, auto setter>
+struct ParameterSetter {
+    static constexpr RemoteParameter value = parameter;
+};
 
-    if (reply.find("ERROR") != std::string::npos) {
-        throw ThalesRemoteError(reply);
+/** The setter of each Remote2 parameter in the order of the table.
+ *
+ *  The setters are written by hand because of their documentation and their different argument types.
+ *  A parameter which is added to the table must also be added here, otherwise the build fails.
+ */
+using ParameterSetters = std::tuple<
+    ParameterSetter<RemoteParameter::CURRENT, &ThalesRemoteScriptWrapper::setCurrent>,
+    ParameterSetter<RemoteParameter::POTENTIAL, &ThalesRemoteScriptWrapper::setPotential>,
+    ParameterSetter<RemoteParameter::MAXIMUM_SHUNT_INDEX, &ThalesRemoteScriptWrapper::setMaximumShuntIndex>,
+    ParameterSetter<RemoteParameter::MINIMUM_SHUNT_INDEX, &ThalesRemoteScriptWrapper::setMinimumShuntIndex>,
+    ParameterSetter<RemoteParameter::VOLTAGE_RANGE_INDEX, &ThalesRemoteScriptWrapper::setVoltageRangeIndex>,
+    ParameterSetter<RemoteParameter::POTENTIOSTAT, &ThalesRemoteScriptWrapper::selectPotentiostat>,
+    ParameterSetter<RemoteParameter::POTENTIOSTAT_WITHOUT_STATE_CHANGE, &ThalesRemoteScriptWrapper::selectPotentiostatWithoutPotentiostatStateChange>,
+    ParameterSetter<RemoteParameter::RULE_FILE_USAGE, &ThalesRemoteScriptWrapper::enableRuleFileUsage>,
+    ParameterSetter<RemoteParameter::PAD4_MODE, &ThalesRemoteScriptWrapper::setupPad4ModeGlobal>,
+    ParameterSetter<RemoteParameter::PAD4_ENABLED, &ThalesRemoteScriptWrapper::enablePad4Global>,
+    ParameterSetter<RemoteParameter::FREQUENCY, &ThalesRemoteScriptWrapper::setFrequency>,
+    ParameterSetter<RemoteParameter::AMPLITUDE, &ThalesRemoteScriptWrapper::setAmplitude>,
+    ParameterSetter<RemoteParameter::NUMBER_OF_PERIODS, &ThalesRemoteScriptWrapper::setNumberOfPeriods>,
+    ParameterSetter<RemoteParameter::UPPER_FREQUENCY_LIMIT, &ThalesRemoteScriptWrapper::setUpperFrequencyLimit>,
+    ParameterSetter<RemoteParameter::LOWER_FREQUENCY_LIMIT, &ThalesRemoteScriptWrapper::setLowerFrequencyLimit>,
+    ParameterSetter<RemoteParameter::START_FREQUENCY, &ThalesRemoteScriptWrapper::setStartFrequency>,
+    ParameterSetter<RemoteParameter::UPPER_STEPS_PER_DECADE, &ThalesRemoteScriptWrapper::setUpperStepsPerDecade>,
+    ParameterSetter<RemoteParameter::LOWER_STEPS_PER_DECADE, &ThalesRemoteScriptWrapper::setLowerStepsPerDecade>,
+    ParameterSetter<RemoteParameter::UPPER_NUMBER_OF_PERIODS, &ThalesRemoteScriptWrapper::setUpperNumberOfPeriods>,
+    ParameterSetter<RemoteParameter::LOWER_NUMBER_OF_PERIODS, &ThalesRemoteScriptWrapper::setLowerNumberOfPeriods>,
+    ParameterSetter<RemoteParameter::SCAN_STRATEGY, &ThalesRemoteScriptWrapper::setScanStrategy>,
+    ParameterSetter<RemoteParameter::SCAN_DIRECTION, &ThalesRemoteScriptWrapper::setScanDirection>,
+    ParameterSetter<RemoteParameter::EIS_NAMING, &ThalesRemoteScriptWrapper::setEISNaming>,
+    ParameterSetter<RemoteParameter::EIS_COUNTER, &ThalesRemoteScriptWrapper::setEISCounter>,
+    ParameterSetter<RemoteParameter::EIS_OUTPUT_PATH, &ThalesRemoteScriptWrapper::setEISOutputPath>,
+    ParameterSetter<RemoteParameter::EIS_OUTPUT_FILE_NAME, &ThalesRemoteScriptWrapper::setEISOutputFileName>,
+    ParameterSetter<RemoteParameter::CV_START_POTENTIAL, &ThalesRemoteScriptWrapper::setCVStartPotential>,
+    ParameterSetter<RemoteParameter::CV_UPPER_REVERSING_POTENTIAL, &ThalesRemoteScriptWrapper::setCVUpperReversingPotential>,
+    ParameterSetter<RemoteParameter::CV_LOWER_REVERSING_POTENTIAL, &ThalesRemoteScriptWrapper::setCVLowerReversingPotential>,
+    ParameterSetter<RemoteParameter::CV_END_POTENTIAL, &ThalesRemoteScriptWrapper::setCVEndPotential>,
+    ParameterSetter<RemoteParameter::CV_START_HOLD_TIME, &ThalesRemoteScriptWrapper::setCVStartHoldTime>,
+    ParameterSetter<RemoteParameter::CV_END_HOLD_TIME, &ThalesRemoteScriptWrapper::setCVEndHoldTime>,
+    ParameterSetter<RemoteParameter::CV_SCAN_RATE, &ThalesRemoteScriptWrapper::setCVScanRate>,
+    ParameterSetter<RemoteParameter::CV_CYCLES, &ThalesRemoteScriptWrapper::setCVCycles>,
+    ParameterSetter<RemoteParameter::CV_SAMPLES_PER_CYCLE, &ThalesRemoteScriptWrapper::setCVSamplesPerCycle>,
+    ParameterSetter<RemoteParameter::CV_MAXIMUM_CURRENT, &ThalesRemoteScriptWrapper::setCVMaximumCurrent>,
+    ParameterSetter<RemoteParameter::CV_MINIMUM_CURRENT, &ThalesRemoteScriptWrapper::setCVMinimumCurrent>,
+    ParameterSetter<RemoteParameter::CV_OHMIC_DROP, &ThalesRemoteScriptWrapper::setCVOhmicDrop>,
+    ParameterSetter<RemoteParameter::CV_AUTO_RESTART_AT_CURRENT_OVERFLOW, &ThalesRemoteScriptWrapper::enableCVAutoRestartAtCurrentOverflow>,
+    ParameterSetter<RemoteParameter::CV_AUTO_RESTART_AT_CURRENT_UNDERFLOW, &ThalesRemoteScriptWrapper::enableCVAutoRestartAtCurrentUnderflow>,
+    ParameterSetter<RemoteParameter::CV_ANALOG_FUNCTION_GENERATOR, &ThalesRemoteScriptWrapper::enableCVAnalogFunctionGenerator>,
+    ParameterSetter<RemoteParameter::CV_NAMING, &ThalesRemoteScriptWrapper::setCVNaming>,
+    ParameterSetter<RemoteParameter::CV_COUNTER, &ThalesRemoteScriptWrapper::setCVCounter>,
+    ParameterSetter<RemoteParameter::CV_OUTPUT_PATH, &ThalesRemoteScriptWrapper::setCVOutputPath>,
+    ParameterSetter<RemoteParameter::CV_OUTPUT_FILE_NAME, &ThalesRemoteScriptWrapper::setCVOutputFileName>,
+    ParameterSetter<RemoteParameter::IE_FIRST_EDGE_POTENTIAL, &ThalesRemoteScriptWrapper::setIEFirstEdgePotential>,
+    ParameterSetter<RemoteParameter::IE_SECOND_EDGE_POTENTIAL, &ThalesRemoteScriptWrapper::setIESecondEdgePotential>,
+    ParameterSetter<RemoteParameter::IE_THIRD_EDGE_POTENTIAL, &ThalesRemoteScriptWrapper::setIEThirdEdgePotential>,
+    ParameterSetter<RemoteParameter::IE_FOURTH_EDGE_POTENTIAL, &ThalesRemoteScriptWrapper::setIEFourthEdgePotential>,
+    ParameterSetter<RemoteParameter::IE_FIRST_EDGE_POTENTIAL_RELATION, &ThalesRemoteScriptWrapper::setIEFirstEdgePotentialRelation>,
+    ParameterSetter<RemoteParameter::IE_SECOND_EDGE_POTENTIAL_RELATION, &ThalesRemoteScriptWrapper::setIESecondEdgePotentialRelation>,
+    ParameterSetter<RemoteParameter::IE_THIRD_EDGE_POTENTIAL_RELATION, &ThalesRemoteScriptWrapper::setIEThirdEdgePotentialRelation>,
+    ParameterSetter<RemoteParameter::IE_FOURTH_EDGE_POTENTIAL_RELATION, &ThalesRemoteScriptWrapper::setIEFourthEdgePotentialRelation>,
+    ParameterSetter<RemoteParameter::IE_POTENTIAL_RESOLUTION, &ThalesRemoteScriptWrapper::setIEPotentialResolution>,
+    ParameterSetter<RemoteParameter::IE_MINIMUM_WAITING_TIME, &ThalesRemoteScriptWrapper::setIEMinimumWaitingTime>,
+    ParameterSetter<RemoteParameter::IE_MAXIMUM_WAITING_TIME, &ThalesRemoteScriptWrapper::setIEMaximumWaitingTime>,
+    ParameterSetter<RemoteParameter::IE_RELATIVE_TOLERANCE, &ThalesRemoteScriptWrapper::setIERelativeTolerance>,
+    ParameterSetter<RemoteParameter::IE_ABSOLUTE_TOLERANCE, &ThalesRemoteScriptWrapper::setIEAbsoluteTolerance>,
+    ParameterSetter<RemoteParameter::IE_OHMIC_DROP, &ThalesRemoteScriptWrapper::setIEOhmicDrop>,
+    ParameterSetter<RemoteParameter::IE_SWEEP_MODE, &ThalesRemoteScriptWrapper::setIESweepMode>,
+    ParameterSetter<RemoteParameter::IE_SCAN_RATE, &ThalesRemoteScriptWrapper::setIEScanRate>,
+    ParameterSetter<RemoteParameter::IE_MAXIMUM_CURRENT, &ThalesRemoteScriptWrapper::setIEMaximumCurrent>,
+    ParameterSetter<RemoteParameter::IE_MINIMUM_CURRENT, &ThalesRemoteScriptWrapper::setIEMinimumCurrent>,
+    ParameterSetter<RemoteParameter::IE_NAMING, &ThalesRemoteScriptWrapper::setIENaming>,
+    ParameterSetter<RemoteParameter::IE_COUNTER, &ThalesRemoteScriptWrapper::setIECounter>,
+    ParameterSetter<RemoteParameter::IE_OUTPUT_PATH, &ThalesRemoteScriptWrapper::setIEOutputPath>,
+    ParameterSetter<RemoteParameter::IE_OUTPUT_FILE_NAME, &ThalesRemoteScriptWrapper::setIEOutputFileName>,
+    ParameterSetter<RemoteParameter::SEQUENCE_NAMING, &ThalesRemoteScriptWrapper::setSequenceNaming>,
+    ParameterSetter<RemoteParameter::SEQUENCE_COUNTER, &ThalesRemoteScriptWrapper::setSequenceCounter>,
+    ParameterSetter<RemoteParameter::SEQUENCE_OUTPUT_PATH, &ThalesRemoteScriptWrapper::setSequenceOutputPath>,
+    ParameterSetter<RemoteParameter::SEQUENCE_OUTPUT_FILE_NAME, &ThalesRemoteScriptWrapper::setSequenceOutputFileName>,
+    ParameterSetter<RemoteParameter::SEQUENCE_ACQ_ENABLED, &ThalesRemoteScriptWrapper::enableSequenceAcqGlobal>,
+    ParameterSetter<RemoteParameter::SEQUENCE_OHMIC_DROP, &ThalesRemoteScriptWrapper::setSequenceOhmicDrop>,
+    ParameterSetter<RemoteParameter::SEQUENCE_MAXIMUM_RUNTIME, &ThalesRemoteScriptWrapper::setSequenceMaximumRuntime>,
+    ParameterSetter<RemoteParameter::SEQUENCE_UPPER_POTENTIAL_LIMIT, &ThalesRemoteScriptWrapper::setSequenceUpperPotentialLimit>,
+    ParameterSetter<RemoteParameter::SEQUENCE_LOWER_POTENTIAL_LIMIT, &ThalesRemoteScriptWrapper::setSequenceLowerPotentialLimit>,
+    ParameterSetter<RemoteParameter::SEQUENCE_UPPER_CURRENT_LIMIT, &ThalesRemoteScriptWrapper::setSequenceUpperCurrentLimit>,
+    ParameterSetter<RemoteParameter::SEQUENCE_LOWER_CURRENT_LIMIT, &ThalesRemoteScriptWrapper::setSequenceLowerCurrentLimit>,
+    ParameterSetter<RemoteParameter::SEQUENCE_CURRENT_RANGE, &ThalesRemoteScriptWrapper::setSequenceCurrentRange>,
+    ParameterSetter<RemoteParameter::SEQUENCE_POTENTIAL_LATENCY_WINDOW, &ThalesRemoteScriptWrapper::setSequencePotentialLatencyWindow>,
+    ParameterSetter<RemoteParameter::SEQUENCE_CURRENT_LATENCY_WINDOW, &ThalesRemoteScriptWrapper::setSequenceCurrentLatencyWindow>,
+    ParameterSetter<RemoteParameter::FRA_MODE, &ThalesRemoteScriptWrapper::enableFraMode>,
+    ParameterSetter<RemoteParameter::FRA_VOLTAGE_INPUT_GAIN, &ThalesRemoteScriptWrapper::setFraVoltageInputGain>,
+    ParameterSetter<RemoteParameter::FRA_VOLTAGE_INPUT_OFFSET, &ThalesRemoteScriptWrapper::setFraVoltageInputOffset>,
+    ParameterSetter<RemoteParameter::FRA_VOLTAGE_OUTPUT_GAIN, &ThalesRemoteScriptWrapper::setFraVoltageOutputGain>,
+    ParameterSetter<RemoteParameter::FRA_VOLTAGE_OUTPUT_OFFSET, &ThalesRemoteScriptWrapper::setFraVoltageOutputOffset>,
+    ParameterSetter<RemoteParameter::FRA_VOLTAGE_MINIMUM, &ThalesRemoteScriptWrapper::setFraVoltageMinimum>,
+    ParameterSetter<RemoteParameter::FRA_VOLTAGE_MAXIMUM, &ThalesRemoteScriptWrapper::setFraVoltageMaximum>,
+    ParameterSetter<RemoteParameter::FRA_CURRENT_INPUT_GAIN, &ThalesRemoteScriptWrapper::setFraCurrentInputGain>,
+    ParameterSetter<RemoteParameter::FRA_CURRENT_INPUT_OFFSET, &ThalesRemoteScriptWrapper::setFraCurrentInputOffset>,
+    ParameterSetter<RemoteParameter::FRA_CURRENT_OUTPUT_GAIN, &ThalesRemoteScriptWrapper::setFraCurrentOutputGain>,
+    ParameterSetter<RemoteParameter::FRA_CURRENT_OUTPUT_OFFSET, &ThalesRemoteScriptWrapper::setFraCurrentOutputOffset>,
+    ParameterSetter<RemoteParameter::FRA_CURRENT_MINIMUM, &ThalesRemoteScriptWrapper::setFraCurrentMinimum>,
+    ParameterSetter<RemoteParameter::FRA_CURRENT_MAXIMUM, &ThalesRemoteScriptWrapper::setFraCurrentMaximum>,
+    ParameterSetter<RemoteParameter::ACQ_CHANNEL, &ThalesRemoteScriptWrapper::readAcqChannel>>;
+
+template <std::size_t... indices>
+constexpr bool isInOrderOfTable(std::index_sequence<indices...>) {
+    return ((std::tuple_element_t<indices, ParameterSetters>::value == static_cast<RemoteParameter>(indices)) && ...);
+}
+
+static_assert(
+    std::tuple_size_v<ParameterSetters> == static_cast<std::size_t>(RemoteParameter::NUMBER_OF_PARAMETERS),
+    "Each parameter of the table needs a setter."
+);
+static_assert(
+    isInOrderOfTable(std::make_index_sequence<std::tuple_size_v<ParameterSetters>>()),
+    "The setters must be listed in the order of the table."
+);
+
+template <RemoteParameter parameter>
+void ThalesRemoteScriptWrapper::appendParameterValue(
+    RemoteCommandEncoder& encoder, const RemoteParameterValue<parameter>& value
+) {
+    constexpr auto& description = remoteParameterDescription<parameter>();
+
+    if constexpr (description.type == RemoteParameterType::TEXT) {
+        encoder.append(value);
+    } else if constexpr (description.type == RemoteParameterType::BOOLEAN) {
+        encoder.append((value == true) ? '1' : '0');
+    } else {
+        // Written negated, so NaN is rejected as well.
+        if (!(value >= description.minimum && value <= description.maximum)) {
+            std::stringstream message;
+            message << description.name << "=" << value << " is outside of the valid range " << description.minimum
+                    << " to " << description.maximum << ".";
+            throw ThalesRemoteError(message.str());
+        }
+
+        if constexpr (description.type == RemoteParameterType::REAL) {
+            encoder.appendScientific(value * description.scale, 10);
+        } else {
+            static_assert(description.scale == 1, "Integer parameters cannot be scaled.");
+            encoder.append(value);
+        }
     }
+}
 
-    return reply;
+template <RemoteParameter parameter>
+std::string ThalesRemoteScriptWrapper::formatParameter(const RemoteParameterValue<parameter>& value) {
+    if constexpr (remoteParameterDescription<parameter>().type == RemoteParameterType::TEXT) {
+        // Text parameters can be longer than the encoder.
+        return value;
+    } else {
+        RemoteCommandEncoder encoder;
+        appendParameterValue<parameter>(encoder, value);
+        return std::string(encoder.view());
+    }
 }
 
-std::string ThalesRemoteScriptWrapper::setValue(std::string name, int value) {
-    std::string reply = this->executeRemoteCommand(name + "=" + std::to_string(value));
+template <RemoteParameter parameter>
+std::string ThalesRemoteScriptWrapper::encodeParameter(const RemoteParameterValue<parameter>& value) {
+    constexpr auto& description = remoteParameterDescription<parameter>();
+    return std::string(description.name) + "=" + formatParameter<parameter>(value);
+}
 
-    if (reply.find("ERROR") != std::string::npos) {
-        throw ThalesRemoteError(reply);
+template <RemoteParameter parameter>
+std::string ThalesRemoteScriptWrapper::setParameter(const RemoteParameterValue<parameter>& value) {
+    constexpr auto& description = remoteParameterDescription<parameter>();
+
+    if constexpr (description.type != RemoteParameterType::TEXT) {
+        if (this->parameterBatchOpen == false) {
+            // The command is encoded on the stack and written to the socket from there.
+            RemoteCommandEncoder command;
+            command.append(description.name).append('=');
+            appendParameterValue<parameter>(command, value);
+            command.frame();
+
+            const auto assignment = command.view().substr(2, command.view().size() - 3);
+            const auto valueText  = assignment.substr(description.name.size() + 1);
+
+            if (const auto cached = this->findInParameterCache(description.name, valueText)) {
+                return cached->reply;
+            }
+            this->prepareRemoteCommand(assignment);
+
+            auto reply = remoteConnection->sendTelegramWithReplyToken(command.view(), 2, 2).getString(
+                remoteConnection->getTimeout()
+            );
+
+            if (reply.find("ERROR") != std::string::npos) {
+                throw ThalesRemoteError(reply);
+            }
+
+            this->storeInParameterCache(description.name, valueText, reply);
+            return reply;
+        }
     }
 
-    return reply;
+    return this->setValue(std::string(description.name), formatParameter<parameter>(value));
 }
 
-std::string ThalesRemoteScriptWrapper::setValue(std::string name, std::string value) {
-    std::string reply = this->executeRemoteCommand(name + "=" + value);
+double ThalesRemoteScriptWrapper::requestValueAndParse(std::string command, std::string_view prefix, std::string_view unit) {
+    return this->parseValue(this->executeRemoteCommand(command), prefix, unit);
+}
 
+double ThalesRemoteScriptWrapper::parseValue(const std::string& reply, std::string_view prefix, std::string_view unit) {
     if (reply.find("ERROR") != std::string::npos) {
         throw ThalesRemoteError(reply);
     }
 
-    return reply;
+    return ReplyParser::parseValue(reply, prefix, unit);
 }
 
 double ThalesRemoteScriptWrapper::requestValueAndParseUsingRegexp(std::string command, std::regex pattern) {
-    double result = std::nan("1");
+    return this->parseValueUsingRegexp(this->executeRemoteCommand(command), pattern);
+}
 
-    std::string reply = this->executeRemoteCommand(command);
+double ThalesRemoteScriptWrapper::parseValueUsingRegexp(const std::string& reply, const std::regex& pattern) {
+    double result = std::nan("1");
 
     if (reply.find("ERROR") != std::string::npos) {
         throw ThalesRemoteError(reply);
@@ -1128,6 +1657,62 @@ double ThalesRemoteScriptWrapper::requestValueAndParseUsingRegexp(std::string co
     return result;
 }
 
+std::string ThalesRemoteScriptWrapper::checkReplyForError(const std::string& reply) {
+    if (reply.find("ERROR") != std::string::npos) {
+        throw ThalesRemoteError(reply);
+    }
+
+    return reply;
+}
+
+template <typename T>
+std::future<T> ThalesRemoteScriptWrapper::requestAsync(std::string command, std::function<T(const std::string&)> parse,
+                                                      ZenniumConnection::SendPriority priority) {
+    auto promise = std::make_shared<std::promise<T>>();
+    auto future  = promise->get_future();
+
+    this->executeRemoteCommandAsync(command, [promise, parse](const std::string& reply, std::exception_ptr error) {
+        if (error) {
+            promise->set_exception(error);
+            return;
+        }
+
+        try {
+            promise->set_value(parse(reply));
+        } catch (...) {
+            promise->set_exception(std::current_exception());
+        }
+    }, priority);
+
+    return future;
+}
+
+template <typename T>
+ThalesAwaitable<T> ThalesRemoteScriptWrapper::requestAwaitable(std::string command, std::function<T(const std::string&)> parse,
+                                                              ZenniumConnection::SendPriority priority) {
+    return ThalesAwaitable<T>([this, command, parse, priority](auto completion) {
+        try {
+            this->executeRemoteCommandAsync(command, [completion, parse](const std::string& reply, std::exception_ptr error) {
+                if (error) {
+                    completion(T(), error);
+                    return;
+                }
+
+                T result;
+                try {
+                    result = parse(reply);
+                } catch (...) {
+                    completion(T(), std::current_exception());
+                    return;
+                }
+                completion(std::move(result), nullptr);
+            }, priority);
+        } catch (...) {
+            completion(T(), std::current_exception());
+        }
+    });
+}
+
 double ThalesRemoteScriptWrapper::stringToDobule(std::string string) {
     std::stringstream stream(string);
     double number;
@@ -28,8 +28,12 @@
 #define THALESREMOTESCRIPTWRAPPER_H
 
 #include <complex>
+#include <future>
+#include <map>
 #include <regex>
 
+#include "remotecommandencoder.h"
+#include "remoteparameters.h"
 #include "thalesremoteconnection.h"
 
 enum class PotentiostatMode {
@@ -77,6 +81,9 @@ enum class Pad4Mode {
  *  Wrapper that uses the ThalesRemoteConnection class.
  *  The commands are explained in https://doc.zahner.de/manuals/remote2.pdf .
  *  In the document you can also find a table with error numbers which are returned.
+ *
+ *  The setters check the values against the limits in remoteParameters before they are sent.
+ *  Invalid values are rejected with a ThalesRemoteError exception without a round trip.
  */
 class ThalesRemoteScriptWrapper {
 public:
@@ -91,6 +98,95 @@ public:
      */
     std::string executeRemoteCommand(std::string command);
 
+    /** Execute several queries to Remote Script pipelined.
+     *
+     *  The commands are sent without waiting for the reply of the previous command, as long as fewer
+     *  commands than the pipeline depth of the connection wait for their reply.
+     *  The pipeline depth is set with ZenniumConnection::setPipelineDepth, with the default depth of 1
+     *  the commands are executed one after the other.
+     *
+     *  The replies are returned in the order of the commands. Errors reported by Thales are not
+     *  evaluated and are contained in the respective reply.
+     *
+     * \param  commands The query strings, e.g. "Frq=1000" or "Pset=0".
+     *
+     * \return The response strings from the device in the order of the commands.
+     */
+    std::vector<std::string> executeRemoteCommands(const std::vector<std::string>& commands);
+
+    /** The result of a parameter which was set in a batch. */
+    struct ParameterResult {
+        std::string command; /**< The command, e.g. "Frq=1.0000000000e+03". */
+        std::string reply;   /**< The response string from the device. */
+        bool success;        /**< false if the device replied with an error to this command. */
+        size_t index;        /**< Position of the parameter in the batch, counted from beginParameterBatch. */
+    };
+
+    /** Start collecting parameters instead of setting them one by one.
+     *
+     *  While the batch is open, the setters which set a single parameter with setValue, e.g. setFrequency
+     *  or setAmplitude, and setPotentiostatMode do not send a command but add it to the batch and return
+     *  an empty string.
+     *  The batch is sent with commitParameterBatch, so a complete setup takes one round trip.
+     *
+     *  All other commands, e.g. getImpedance or enablePotentiostat, first send the collected parameters
+     *  to keep the order of the commands. The batch remains open and the results of these parameters are
+     *  returned by commitParameterBatch. The other command does not throw an exception because of them.
+     */
+    void beginParameterBatch();
+
+    /** Send the parameters collected since beginParameterBatch and close the batch.
+     *
+     *  The parameters are sent as colon separated command lists, split into several telegrams if the
+     *  payload would exceed 65535 bytes. The device replies once to each command list. Because an error
+     *  reply does not tell which command failed, the parameters of a rejected list are sent again one per
+     *  telegram, so each parameter gets its own reply. Setting a parameter again to the same value does
+     *  not change the setup. Only accepted parameters are stored in the parameter cache.
+     *
+     * \return The results of all parameters since beginParameterBatch in the order of the parameters,
+     *          including the parameters which were sent before other commands.
+     */
+    std::vector<ParameterResult> commitParameterBatch();
+
+    /** Enable or disable the cache of the parameters set with this wrapper.
+     *
+     *  With the cache, the wrapper remembers the last value of each parameter which was acknowledged by
+     *  the device, e.g. Frq or Pset. A setter which would write the same value again does not send a
+     *  command and returns the reply of the last write.
+     *
+     *  The cache is cleared when the wrapper cannot know the state of the device anymore. This is the
+     *  case after readSetup, measurements such as measureEIS, switching the rule file usage or the
+     *  potentiostat, forceThalesIntoRemoteScript, unknown commands passed to executeRemoteCommand and
+     *  after a reconnect of the connection. While the rule file is used, Thales can change the written
+     *  values, so no parameters are cached.
+     *
+     *  The cache is disabled by default.
+     *
+     * \param enabled true to enable the cache, false to disable and clear it.
+     */
+    void enableParameterCache(bool enabled = true);
+
+    /** Disable and clear the parameter cache. */
+    void disableParameterCache();
+
+    /** Clear the parameter cache, so the next write of each parameter is sent to the device.
+     *
+     *  This must be called if the parameters were changed without this wrapper, e.g. in the Thales GUI.
+     */
+    void clearParameterCache();
+
+    /** Get the number of writes which were not sent because the parameter already had the value.
+     *
+     * \return The number of cache hits.
+     */
+    unsigned long getParameterCacheHits() const;
+
+    /** Get the number of writes which were sent while the cache was enabled.
+     *
+     * \return The number of cache misses.
+     */
+    unsigned long getParameterCacheMisses() const;
+
     /** Prompts Thales to start the Remote Script
      *
      * Will switch a running Thales from anywhere like the main menu after
@@ -138,6 +234,9 @@ public:
      * However, a time in seconds can optionally be specified for the timeout. When the timeout expires, an exception is
      * thrown by the socket.
      *
+     * The reply is identified by its beginning "1,<connection name>,", so it is received even if other
+     * requests on the control channel are never answered, see ZenniumConnection::sendTelegramWithReplyToken.
+     *
      * \return The HeartBeat time in milli seconds.
      */
     int getWorkstationHeartBeat();
@@ -320,6 +419,9 @@ public:
     std::string enablePotentiostat(bool enabled = true);
 
     /** Switch the potentiostat off.
+     *
+     *  The command is sent with urgent priority, so it does not wait for commands of other threads
+     *  which are still waiting in the send queue or for a free place in the pipeline.
      *
      * \return The response string from the device.
      */
@@ -468,9 +570,11 @@ public:
 
     /** Set the number of periods to average for one impedance measurement.
      *
-     * \param  numberOfPeriods The number of periods / waves to average.
+     * \param  numberOfPeriods The number of periods / waves to average, 1 to 100.
      *
      * \return The response string from the device.
+     *
+     * \throws ThalesRemoteError if the number is outside of the valid range.
      */
     std::string setNumberOfPeriods(int numberOfPeriods);
 
@@ -569,7 +673,9 @@ public:
      * \param  frequency The frequency to measure the impedance at.
      * \param  amplitude The amplitude to measure the impedance with. In Volt if potentiostatic mode or Ampere for
      * galvanostatic mode.
-     * \param  numberOfPeriods The number of periods / waves to average.
+     * \param  numberOfPeriods The number of periods / waves to average, 1 to 100.
+     *
+     *  The parameters and the IMPEDANCE command are sent in one telegram.
      *
      * \return The complex impedance at the measured point.
      */
@@ -597,7 +703,7 @@ public:
      * \param  frequency The frequency to measure the impedance at.
      * \param  amplitude The amplitude to measure the impedance with. In Volt if potentiostatic mode or Ampere for
      * galvanostatic mode.
-     * \param  numberOfPeriods The number of periods / waves to average.
+     * \param  numberOfPeriods The number of periods / waves to average, 1 to 100.
      *
      * \return String containing the impedance results.
      */
@@ -1533,6 +1639,213 @@ public:
      */
     std::string disableAcq();
 
+    /*
+     * Section with asynchronous methods
+     *
+     * These methods send the command and return immediately. The reply is delivered by the receive
+     * thread of the connection, so one thread can have many commands to many devices outstanding.
+     * Errors reported by Thales are thrown by the future as ThalesRemoteError exception.
+     */
+
+    /** Directly execute a query to Remote Script without waiting for the reply.
+     *
+     * \param  command The query string, e.g. "IMPEDANCE" or "Pset=0"
+     *
+     * \return Future which returns the response string from the device.
+     */
+    std::future<std::string> executeRemoteCommandAsync(std::string command);
+
+    /** Directly execute a query to Remote Script and call the callback with the reply.
+     *
+     *  The callback is called by the receive thread of the connection, see
+     *  ZenniumConnection::sendStringAndWaitForReplyStringAsync.
+     *
+     *  An urgent command is sent before the commands waiting in the send queue and does not send the
+     *  open parameter batch first.
+     *
+     * \param  command The query string, e.g. "IMPEDANCE" or "Pset=0"
+     * \param  callback Is called with the response string or the error.
+     * \param  priority The priority of the command.
+     */
+    void executeRemoteCommandAsync(std::string command, ZenniumConnection::ReplyCallback callback,
+                                   ZenniumConnection::SendPriority priority = ZenniumConnection::SendPriority::NORMAL);
+
+    /** Read the measured current from the device without waiting.
+     *
+     * \return Future which returns the current current value.
+     */
+    std::future<double> getCurrentAsync();
+
+    /** Read the measured voltage from the device without waiting.
+     *
+     * \return Future which returns the current voltage value.
+     */
+    std::future<double> getPotentialAsync();
+
+    /** Read the measured voltage from the device without waiting.
+     *
+     * \return Future which returns the current voltage value.
+     */
+    std::future<double> getVoltageAsync();
+
+    /** Measure the impedance at the set frequency, amplitude and averages without waiting.
+     *
+     * \return Future which returns the complex impedance at the measured point.
+     */
+    std::future<std::complex<double>> getImpedanceAsync();
+
+    /** Set the output current without waiting.
+     *
+     * \param  current The output current to set.
+     *
+     * \return Future which returns the response string from the device.
+     */
+    std::future<std::string> setCurrentAsync(double current);
+
+    /** Set the output potential without waiting.
+     *
+     * \param  potential The output potential to set.
+     *
+     * \return Future which returns the response string from the device.
+     */
+    std::future<std::string> setPotentialAsync(double potential);
+
+    /** Set the frequency of the impedance measurement without waiting.
+     *
+     * \param  frequency The frequency to set.
+     *
+     * \return Future which returns the response string from the device.
+     */
+    std::future<std::string> setFrequencyAsync(double frequency);
+
+    /** Set the amplitude of the impedance measurement without waiting.
+     *
+     * \param  amplitude The amplitude to set in Volt if potentiostatic mode or Ampere for galvanostatic mode.
+     *
+     * \return Future which returns the response string from the device.
+     */
+    std::future<std::string> setAmplitudeAsync(double amplitude);
+
+    /** Set the number of periods to average for the impedance measurement without waiting.
+     *
+     * \param  numberOfPeriods The number of periods / waves to average, 1 to 100.
+     *
+     * \return Future which returns the response string from the device.
+     */
+    std::future<std::string> setNumberOfPeriodsAsync(int numberOfPeriods);
+
+    /** Switch the potentiostat on or off without waiting.
+     *
+     *  Switching off is sent with urgent priority like disablePotentiostat.
+     *
+     * \param  enabled true to enable the potentiostat.
+     *
+     * \return Future which returns the response string from the device.
+     */
+    std::future<std::string> enablePotentiostatAsync(bool enabled = true);
+
+    /** Switch the potentiostat off without waiting.
+     *
+     * \return Future which returns the response string from the device.
+     */
+    std::future<std::string> disablePotentiostatAsync();
+
+    /*
+     * Section with awaitable methods for C++20 coroutines
+     *
+     * The command is sent when the awaitable is awaited with co_await. The coroutine is resumed when the
+     * reply has arrived, see ThalesAwaitable. Errors reported by Thales are thrown by co_await as
+     * ThalesRemoteError exception.
+     */
+
+    /** Directly execute a query to Remote Script.
+     *
+     * \param  command The query string, e.g. "IMPEDANCE" or "Pset=0"
+     *
+     * \return Awaitable which returns the response string from the device.
+     */
+    ThalesAwaitable<std::string> executeRemoteCommandAwaitable(std::string command);
+
+    /** Read the measured current from the device.
+     *
+     * \return Awaitable which returns the current current value.
+     */
+    ThalesAwaitable<double> getCurrentAwaitable();
+
+    /** Read the measured voltage from the device.
+     *
+     * \return Awaitable which returns the current voltage value.
+     */
+    ThalesAwaitable<double> getPotentialAwaitable();
+
+    /** Read the measured voltage from the device.
+     *
+     * \return Awaitable which returns the current voltage value.
+     */
+    ThalesAwaitable<double> getVoltageAwaitable();
+
+    /** Measure the impedance at the set frequency, amplitude and averages.
+     *
+     * \return Awaitable which returns the complex impedance at the measured point.
+     */
+    ThalesAwaitable<std::complex<double>> getImpedanceAwaitable();
+
+    /** Set the output current.
+     *
+     * \param  current The output current to set.
+     *
+     * \return Awaitable which returns the response string from the device.
+     */
+    ThalesAwaitable<std::string> setCurrentAwaitable(double current);
+
+    /** Set the output potential.
+     *
+     * \param  potential The output potential to set.
+     *
+     * \return Awaitable which returns the response string from the device.
+     */
+    ThalesAwaitable<std::string> setPotentialAwaitable(double potential);
+
+    /** Set the frequency of the impedance measurement.
+     *
+     * \param  frequency The frequency to set.
+     *
+     * \return Awaitable which returns the response string from the device.
+     */
+    ThalesAwaitable<std::string> setFrequencyAwaitable(double frequency);
+
+    /** Set the amplitude of the impedance measurement.
+     *
+     * \param  amplitude The amplitude to set in Volt if potentiostatic mode or Ampere for galvanostatic mode.
+     *
+     * \return Awaitable which returns the response string from the device.
+     */
+    ThalesAwaitable<std::string> setAmplitudeAwaitable(double amplitude);
+
+    /** Set the number of periods to average for the impedance measurement.
+     *
+     * \param  numberOfPeriods The number of periods / waves to average, 1 to 100.
+     *
+     * \return Awaitable which returns the response string from the device.
+     */
+    ThalesAwaitable<std::string> setNumberOfPeriodsAwaitable(int numberOfPeriods);
+
+    /** Switch the potentiostat on or off.
+     *
+     *  Switching off is sent with urgent priority like disablePotentiostat.
+     *
+     * \param  enabled true to enable the potentiostat.
+     *
+     * \return Awaitable which returns the response string from the device.
+     */
+    ThalesAwaitable<std::string> enablePotentiostatAwaitable(bool enabled = true);
+
+    /** Switch the potentiostat off.
+     *
+     * \return Awaitable which returns the response string from the device.
+     */
+    ThalesAwaitable<std::string> disablePotentiostatAwaitable();
+
 protected:
     /** Set an Remote2 parameter or value.
      *
@@ -1590,6 +1903,30 @@ protected:
     std::string setValue(std::string name, std::string value);
 
     /** Sending a Remote2 command and parsing a double from the response.
+     *
+     * \param  command Name of the Remote2 command.
+     * \param  prefix The text in front of the value, e.g. "current=".
+     * \param  unit The text which must follow the value, e.g. "A", or empty if the value ends the reply.
+     *
+     * \return The received value or NaN if the response has a different format.
+     */
+    double requestValueAndParse(std::string command, std::string_view prefix, std::string_view unit = {});
+
+    /** Parsing a double from the response of a Remote2 command without regular expressions.
+     *
+     *  If the response contains an error, a ThalesRemoteError exception is thrown.
+     *
+     * \param  reply The response string from the device.
+     * \param  prefix The text in front of the value, e.g. "current=".
+     * \param  unit The text which must follow the value, e.g. "A", or empty if the value ends the reply.
+     *
+     * \return The received value or NaN if the response has a different format.
+     */
+    double parseValue(const std::string& reply, std::string_view prefix, std::string_view unit = {});
+
+    /** Sending a Remote2 command and parsing a double from the response.
+     *
+     *  For replies without a fixed format. Building the regex is expensive, so the getters use requestValueAndParse.
      *
      * \param  command Name of the Remote2 command.
      * \param  pattern The regex to extract the value from the response string.
@@ -1598,6 +1935,100 @@ protected:
      */
     double requestValueAndParseUsingRegexp(std::string command, std::regex pattern);
 
+    /** Parsing a double from the response of a Remote2 command.
+     *
+     *  If the response contains an error, a ThalesRemoteError exception is thrown.
+     *
+     * \param  reply The response string from the device.
+     * \param  pattern The regex to extract the value from the response string.
+     *
+     * \return The received value.
+     */
+    double parseValueUsingRegexp(const std::string& reply, const std::regex& pattern);
+
+    /** Parsing the complex impedance from the response of the IMPEDANCE command.
+     *
+     * \param  reply The response string from the device.
+     *
+     * \return The complex impedance.
+     */
+    std::complex<double> parseImpedance(const std::string& reply);
+
+    /** Throws a ThalesRemoteError exception if the response contains an error.
+     *
+     * \param  reply The response string from the device.
+     *
+     * \return The unchanged response string.
+     */
+    static std::string checkReplyForError(const std::string& reply);
+
+    /** Execute a Remote2 command asynchronously and convert the reply.
+     *
+     * \param  command The query string.
+     * \param  parse Function that converts the response string into the result.
+     * \param  priority The priority of the command.
+     *
+     * \return Future which returns the converted reply.
+     */
+    template <typename T>
+    std::future<T> requestAsync(std::string command, std::function<T(const std::string&)> parse,
+                                ZenniumConnection::SendPriority priority = ZenniumConnection::SendPriority::NORMAL);
+
+    /** Execute a Remote2 command when awaited and convert the reply.
+     *
+     * \param  command The query string.
+     * \param  parse Function that converts the response string into the result.
+     * \param  priority The priority of the command.
+     *
+     * \return Awaitable which returns the converted reply.
+     */
+    template <typename T>
+    ThalesAwaitable<T> requestAwaitable(std::string command, std::function<T(const std::string&)> parse,
+                                        ZenniumConnection::SendPriority priority = ZenniumConnection::SendPriority::NORMAL);
+
+    /** Checks the value of a parameter and appends the text which is sent to Remote2 to the encoder.
+     *
+     *  The limits, the type and the unit of the parameter are taken from remoteParameters at compile time.
+     *
+     * \param  encoder The encoder of the command.
+     * \param  value The value in the unit of the setter, e.g. V for RemoteParameter::AMPLITUDE.
+     *
+     * \throws ThalesRemoteError if the value is outside of the limits of the parameter.
+     */
+    template <RemoteParameter parameter>
+    static void appendParameterValue(RemoteCommandEncoder& encoder, const RemoteParameterValue<parameter>& value);
+
+    /** Checks the value of a parameter and converts it into the text which is sent to Remote2.
+     *
+     * \param  value The value in the unit of the setter, e.g. V for RemoteParameter::AMPLITUDE.
+     *
+     * \return The value as text, e.g. "1.0000000000e+01".
+     *
+     * \throws ThalesRemoteError if the value is outside of the limits of the parameter.
+     */
+    template <RemoteParameter parameter>
+    static std::string formatParameter(const RemoteParameterValue<parameter>& value);
+
+    /** Checks the value of a parameter and returns the command which sets it, e.g. "Frq=1.0000000000e+03".
+     *
+     * \throws ThalesRemoteError if the value is outside of the limits of the parameter.
+     */
+    template <RemoteParameter parameter>
+    static std::string encodeParameter(const RemoteParameterValue<parameter>& value);
+
+    /** Checks the value of a parameter and sets it with setValue.
+     *
+     *  Invalid values are rejected before anything is sent to the device.
+     *
+     * \param  value The value in the unit of the setter.
+     *
+     * \return The response string from the device.
+     *
+     * \throws ThalesRemoteError if the value is outside of the limits of the parameter.
+     */
+    template <RemoteParameter parameter>
+    std::string setParameter(const RemoteParameterValue<parameter>& value);
+
     /** Converts a string to double.
      *
      * This needed to be added because the numberical strings delivered
@@ -1617,7 +2048,61 @@ protected:
      */
     int stringToInt(std::string string);
 
+    /** Sends the parameters of an open batch before another command, the batch remains open.
+     *
+     *  The results are kept for commitParameterBatch.
+     */
+    void flushParameterBatch();
+
+    /** Sends the collected parameters and adds their results to parameterBatchResults.
+     *
+     * \param  command Command which is appended to the last command list, so it needs no additional round trip.
+     *
+     * \return The reply to the command list which contains the command, empty without command.
+     */
+    std::string sendParameterBatch(const std::string& command = std::string());
+
+    /** Value of a parameter as acknowledged by the device. */
+    struct CachedParameter {
+        std::string value;
+        std::string reply;
+    };
+
+    /** Called before each command is sent, so that no command bypasses the open batch or the cache.
+     *
+     *  Sends the parameters of an open batch and removes the cached values which the command can change.
+     *
+     * \param command Colon separated commands without the "1:" frame, e.g. "Frq=1000".
+     */
+    void prepareRemoteCommand(std::string_view command);
+
+    /** Adds a command to the open parameter batch. */
+    void addToParameterBatch(std::string command);
+
+    /** Removes the cached values which the command can change, before it is sent.
+     *
+     * \param command Colon separated commands, e.g. "Frq=1000" or "Gal=0:GAL=0".
+     */
+    void invalidateParameterCache(std::string_view command);
+
+    /** Returns the cached value if the parameter already has this value, otherwise nullptr. Counts the hits and misses. */
+    const CachedParameter* findInParameterCache(std::string_view name, std::string_view value);
+
+    /** Stores the value of a parameter acknowledged by the device, if the parameter can be cached. */
+    void storeInParameterCache(std::string_view name, std::string_view value, const std::string& reply);
+
     ZenniumConnection* const remoteConnection;
+
+    bool parameterBatchOpen;
+    std::vector<std::string> parameterBatch;
+    std::vector<ParameterResult> parameterBatchResults;
+
+    bool parameterCacheEnabled;
+    bool ruleFileInUse;
+    unsigned long parameterCacheConnection;
+    unsigned long parameterCacheHits;
+    unsigned long parameterCacheMisses;
+    std::map<std::string, CachedParameter, std::less<>> parameterCache;
 };
 
 #endif  // THALESREMOTESCRIPTWRAPPER_H
@@ -0,0 +1,90 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "threadpoolexecutor.h"
+
+ThreadPoolExecutor::ThreadPoolExecutor(int numberOfThreads) :
+    running(true)
+{
+    for(int i = 0; i < std::max(numberOfThreads, 1); i++)
+    {
+        this->workers.emplace_back(&ThreadPoolExecutor::workerJob, this);
+    }
+}
+
+ThreadPoolExecutor::~ThreadPoolExecutor()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->running = false;
+    }
+    this->taskAvailable.notify_all();
+
+    for(auto &worker : this->workers)
+    {
+        worker.join();
+    }
+}
+
+void ThreadPoolExecutor::post(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->tasks.push(std::move(task));
+    }
+    this->taskAvailable.notify_one();
+}
+
+void ThreadPoolExecutor::workerJob()
+{
+    while (true)
+    {
+        std::function<void()> task;
+
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->taskAvailable.wait(lock, [this]() {
+                return this->tasks.empty() == false || this->running == false;
+            });
+
+            if (this->tasks.empty() == true)
+            {
+                return;
+            }
+
+            task = std::move(this->tasks.front());
+            this->tasks.pop();
+        }
+
+        try
+        {
+            task();
+        }
+        catch (...)
+        {
+            // Exceptions of tasks must not terminate the thread.
+        }
+    }
+}
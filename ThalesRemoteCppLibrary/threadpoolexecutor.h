@@ -0,0 +1,77 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef THREADPOOLEXECUTOR_H
+#define THREADPOOLEXECUTOR_H
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+/** Class which executes tasks with a fixed number of threads.
+ *
+ *  If an executor is set at the ZenniumConnection, the callbacks of asynchronous requests and
+ *  the continuations of coroutines are executed by the executor instead of the receive thread.
+ *  This way the callbacks can block or send further requests without stopping the reception of telegrams.
+ */
+class ThreadPoolExecutor
+{
+public:
+
+    /** Constructor.
+     *
+     * \param numberOfThreads Number of threads which execute the tasks.
+     */
+    explicit ThreadPoolExecutor(int numberOfThreads = 1);
+    ThreadPoolExecutor(const ThreadPoolExecutor &) = delete;
+    ThreadPoolExecutor& operator=(const ThreadPoolExecutor &) = delete;
+
+    /** Destructor. Executes the tasks which are still queued and stops the threads. */
+    ~ThreadPoolExecutor();
+
+    /** Queue a task for execution.
+     *
+     *  Exceptions thrown by the task are ignored.
+     *
+     * \param task The task to execute.
+     */
+    void post(std::function<void()> task);
+
+protected:
+
+    std::mutex mutex;
+    std::condition_variable taskAvailable;
+    std::queue<std::function<void()>> tasks;
+    bool running;
+    std::vector<std::thread> workers;
+
+    /** The method running in the threads of the executor. */
+    void workerJob();
+};
+
+#endif // THREADPOOLEXECUTOR_H
@@ -25,9 +25,16 @@
  */
 #include "threadsafequeue.h"
 
-ThreadsafeQueue::ThreadsafeQueue()
+#include <algorithm>
+
+ThreadsafeQueue::ThreadsafeQueue(size_t capacity, OverflowPolicy overflowPolicy) :
+    capacity(capacity),
+    overflowPolicy(overflowPolicy),
+    droppedCount(0),
+    interrupted(false),
+    releaseCount(0)
 {
-    dataAvailable.lock();
+
 }
 
 ThreadsafeQueue::~ThreadsafeQueue() { }
@@ -44,49 +51,185 @@ unsigned long ThreadsafeQueue::size() const
     return queue.size();
 }
 
-std::vector<uint8_t> ThreadsafeQueue::pop()
+Telegram ThreadsafeQueue::pop()
 {
-    std::lock_guard<std::mutex> lock(mutex);
+    std::unique_lock<std::mutex> lock(mutex);
     if (queue.empty()) {
         return {};
     }
-    std::vector<uint8_t> tmp = queue.front();
-    queue.pop();
+    Telegram tmp = takeFront();
+    lock.unlock();
+    spaceAvailable.notify_one();
     return tmp;
 }
 
-void ThreadsafeQueue::put(const std::vector<uint8_t> &item)
+void ThreadsafeQueue::put(Telegram &&item)
 {
-    std::lock_guard<std::mutex> lock(mutex);
-    queue.push(item);
-    dataAvailable.unlock();
+    std::unique_lock<std::mutex> lock(mutex);
+    if (item.size() > 0 && overflowPolicy == OverflowPolicy::BLOCK) {
+        spaceAvailable.wait(lock, [this]() { return isFull() == false || interrupted == true; });
+    }
+    insert(std::move(item));
+    lock.unlock();
+    dataAvailable.notify_one();
+}
+
+bool ThreadsafeQueue::tryPut(Telegram &&item)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    if (item.size() > 0 && overflowPolicy == OverflowPolicy::BLOCK && isFull() == true && interrupted == false) {
+        return false;
+    }
+    insert(std::move(item));
+    lock.unlock();
+    dataAvailable.notify_one();
+    return true;
 }
 
-std::vector<uint8_t> ThreadsafeQueue::get(const bool blocking, const std::chrono::duration<int, std::milli> timeout)
+bool ThreadsafeQueue::waitForSpace()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    if (overflowPolicy == OverflowPolicy::BLOCK) {
+        spaceAvailable.wait(lock, [this]() { return isFull() == false || interrupted == true; });
+    }
+    return interrupted == false;
+}
+
+void ThreadsafeQueue::setInterrupted(bool interrupted)
 {
-    std::vector<uint8_t> retval = {};
-    if(blocking == false)
     {
-        retval = this->pop();
+        std::lock_guard<std::mutex> lock(mutex);
+        this->interrupted = interrupted;
     }
-    else
+    spaceAvailable.notify_all();
+}
+
+void ThreadsafeQueue::setCapacity(size_t capacity, OverflowPolicy overflowPolicy)
+{
     {
-        std::chrono::milliseconds startTime = std::chrono::duration_cast<std::chrono::milliseconds >(std::chrono::system_clock::now().time_since_epoch());
-        std::chrono::duration<int, std::milli> remainingTime;
-        std::chrono::duration<int, std::milli> elapsedTime;
-
-        while (this->empty() == true)
-        {
-            elapsedTime = std::chrono::duration_cast<std::chrono::milliseconds >(std::chrono::system_clock::now().time_since_epoch()) - startTime;
-            if (elapsedTime > timeout)
-            {
-                break;
-            }
-            remainingTime = timeout - elapsedTime;
-
-            dataAvailable.try_lock_for(remainingTime);
+        std::lock_guard<std::mutex> lock(mutex);
+        this->capacity = capacity;
+        this->overflowPolicy = overflowPolicy;
+        while (capacity > 0 && queue.size() - releaseCount > capacity) {
+            dropOldest();
+            droppedCount++;
         }
-        retval = this->pop();
     }
+    spaceAvailable.notify_all();
+}
+
+size_t ThreadsafeQueue::getCapacity() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return capacity;
+}
+
+ThreadsafeQueue::OverflowPolicy ThreadsafeQueue::getOverflowPolicy() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return overflowPolicy;
+}
+
+unsigned long ThreadsafeQueue::getDroppedCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return droppedCount;
+}
+
+bool ThreadsafeQueue::isFull() const
+{
+    return capacity > 0 && queue.size() - releaseCount >= capacity;
+}
+
+void ThreadsafeQueue::insert(Telegram &&item)
+{
+    if (item.size() == 0) {
+        releaseCount++;
+        queue.push_back(std::move(item));
+        return;
+    }
+
+    if (isFull() == false) {
+        queue.push_back(std::move(item));
+        return;
+    }
+
+    droppedCount++;
+
+    // A full queue contains at least one element which is not empty, the empty elements must still release the waiting threads.
+    switch (overflowPolicy) {
+    case OverflowPolicy::DROP_OLDEST:
+        dropOldest();
+        queue.push_back(std::move(item));
+        break;
+    case OverflowPolicy::COALESCE_LATEST:
+        *std::find_if(queue.rbegin(), queue.rend(), [](const Telegram &element) { return element.size() > 0; }) = std::move(item);
+        break;
+    case OverflowPolicy::BLOCK:
+    case OverflowPolicy::DROP_NEWEST:
+        break;
+    }
+}
+
+Telegram ThreadsafeQueue::takeFront()
+{
+    Telegram item = std::move(queue.front());
+    queue.pop_front();
+    if (item.size() == 0) {
+        releaseCount--;
+    }
+    return item;
+}
+
+void ThreadsafeQueue::dropOldest()
+{
+    queue.erase(std::find_if(queue.begin(), queue.end(), [](const Telegram &element) { return element.size() > 0; }));
+}
+
+Telegram ThreadsafeQueue::get(const bool blocking, const std::chrono::duration<int, std::milli> timeout)
+{
+    if (blocking == false) {
+        return this->pop();
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    auto dataInQueue = [this]() { return queue.empty() == false; };
+
+    if (timeout == std::chrono::duration<int, std::milli>::max()) {
+        dataAvailable.wait(lock, dataInQueue);
+    } else if (dataAvailable.wait_until(lock, std::chrono::steady_clock::now() + timeout, dataInQueue) == false) {
+        return {};
+    }
+
+    Telegram retval = takeFront();
+    lock.unlock();
+    spaceAvailable.notify_one();
     return retval;
-};
+}
+
+size_t ThreadsafeQueue::drain(std::vector<Telegram> &out, size_t maxCount, const std::chrono::duration<int, std::milli> timeout)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    auto dataInQueue = [this]() { return queue.empty() == false; };
+
+    if (timeout == std::chrono::duration<int, std::milli>::max()) {
+        dataAvailable.wait(lock, dataInQueue);
+    } else if (dataAvailable.wait_until(lock, std::chrono::steady_clock::now() + timeout, dataInQueue) == false) {
+        return 0;
+    }
+
+    size_t count = 0;
+    while (queue.empty() == false && (maxCount == 0 || count < maxCount)) {
+        if (queue.front().size() == 0 && count > 0) {
+            break;
+        }
+        out.push_back(takeFront());
+        count++;
+        if (out.back().size() == 0) {
+            break;
+        }
+    }
+    lock.unlock();
+    spaceAvailable.notify_all();
+    return count;
+}
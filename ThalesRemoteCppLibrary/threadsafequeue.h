@@ -26,66 +26,77 @@
 #ifndef THREADSAFEQUEUE_H
 #define THREADSAFEQUEUE_H
 
-#include <queue>
+#include <deque>
 #include <mutex>
+#include <condition_variable>
 #include <vector>
 #include <cstring>
+#include <cstdint>
+#include <chrono>
+#include "telegramqueue.h"
 
 /** Class which implements a thread-safe FIFO queue.
  *
+ *  The queue can be limited to a capacity. What happens when a full queue receives another
+ *  element is defined by the OverflowPolicy. Empty elements, which are used to release waiting
+ *  threads, are always added regardless of the capacity and are never removed or replaced by the
+ *  overflow policy.
+ *
+ *  Any number of threads can write and read the queue, the accesses are protected by a mutex.
  */
-class ThreadsafeQueue
+class ThreadsafeQueue : public TelegramQueue
 {
-    std::queue< std::vector<uint8_t> > queue;
+    std::deque< Telegram > queue;
     mutable std::mutex mutex;
-    std::timed_mutex dataAvailable;
+    std::condition_variable dataAvailable;
+    std::condition_variable spaceAvailable;
 
-public:
-    ThreadsafeQueue();
-    ThreadsafeQueue(const ThreadsafeQueue &) = delete ;
-    ThreadsafeQueue& operator=(const ThreadsafeQueue &) = delete ;
+    size_t capacity;
+    OverflowPolicy overflowPolicy;
+    unsigned long droppedCount;
+    bool interrupted;
 
-    virtual ~ThreadsafeQueue();
+    /** Number of empty elements in the queue, they do not count towards the capacity. */
+    size_t releaseCount;
 
-    /** Check if the queue is empty.
-     *
-     * @return true if the queue is empty.
-     */
-    bool empty() const;
+    /** Checks if the queue is full. The caller must hold the mutex. */
+    bool isFull() const;
 
-    /** Returns the number of elements in the queue.
-     *
-     *  The number of byte arrays in the queue.
-     *
-     * @return Number of elements in the queue.
-     */
-    unsigned long size() const;
+    /** Adds the element according to the overflow policy. The caller must hold the mutex and the queue must not be full for BLOCK. */
+    void insert(Telegram &&item);
 
-    /** Adding an element to the queue.
-     *
-     * @param item The element to add.
-     */
-    void put(const std::vector<uint8_t> &item);
+    /** Removes and returns the first element. The caller must hold the mutex and the queue must not be empty. */
+    Telegram takeFront();
 
-    /** Non-blocking read from the queue.
-     *
-     * If the queue is empty, a vector with length 0 is returned.
-     *
-     * @return An element of the queue.
-     */
-    std::vector<uint8_t> pop();
+    /** Removes the oldest element which is not empty. The caller must hold the mutex and the queue must be full. */
+    void dropOldest();
 
-    /** Blocking and non-blocking read from the queue.
-     *
-     * If blocking is false the pop method is executed.
-     * If blocking is true it will wait for the timeout time to be read if there are no elements in the queue.
-     * After a timeout a vector with length 0 is returned.
+public:
+    /** Constructor.
      *
-     * @param blocking true to wait for timeout time.
-     * @param timeout Time to wairt for data.
-     * @return An element of the queue.
+     * @param capacity Maximum number of elements, 0 for unlimited.
+     * @param overflowPolicy Behaviour when an element is added to a full queue.
      */
-    std::vector<uint8_t> get(const bool blocking = true, const std::chrono::duration<int, std::milli> timeout = std::chrono::duration<int, std::milli>::max());
+    ThreadsafeQueue(size_t capacity = 0, OverflowPolicy overflowPolicy = OverflowPolicy::DROP_OLDEST);
+
+    virtual ~ThreadsafeQueue();
+
+    using TelegramQueue::put;
+    using TelegramQueue::tryPut;
+
+    bool empty() const override;
+    unsigned long size() const override;
+    void put(Telegram &&item) override;
+    bool tryPut(Telegram &&item) override;
+    bool waitForSpace() override;
+    void setInterrupted(bool interrupted) override;
+    void setCapacity(size_t capacity, OverflowPolicy overflowPolicy) override;
+    size_t getCapacity() const override;
+    OverflowPolicy getOverflowPolicy() const override;
+    unsigned long getDroppedCount() const override;
+    Telegram pop() override;
+    Telegram get(const bool blocking = true, const std::chrono::duration<int, std::milli> timeout = std::chrono::duration<int, std::milli>::max()) override;
+    size_t drain(std::vector<Telegram> &out, size_t maxCount = 0, const std::chrono::duration<int, std::milli> timeout = std::chrono::duration<int, std::milli>::max()) override;
 };
 
 #endif // THREADSAFEQUEUE_H